@@ -0,0 +1,311 @@
+/**
+ * @file AsyncPageWriter.hpp
+ * @brief Double-buffered 24FC256 page writer over an async I2C bus
+ *
+ * Same staging as EEPROMPageWriter (samples collected in a RAM page image,
+ * one page write per 32 samples), but the page write is submitted to an
+ * IAsyncI2CController instead of blocking on the bus:
+ *
+ *   buffer A: filling            buffer B: idle
+ *   A full -> A submitted        B: filling   (A on the wire)
+ *   A done (interrupt) -> idle   B full -> B submitted, A filling ...
+ *
+ * so sampling continues while the previous page is on the wire. The
+ * completion callback only records the result. A page the EEPROM NACKed
+ * (still in its write cycle) is not resent right away: Poll() from the
+ * main loop submits a zero-length ACK poll (one address byte on the wire)
+ * and requeues the page write only once the device has ACKed a poll,
+ * which is the deferred form of ACK polling.
+ *
+ * Flush() submits the staged-but-unwritten bytes of the current page and
+ * keeps filling the same page in the other buffer, so a partial page can
+ * be made durable and continued like with EEPROMPageWriter.
+ *
+ * If both buffers are busy when a page fills, the full page stays staged
+ * and further Append() calls fail until a buffer is free; call Poll() and
+ * let the bus run.
+ */
+
+#pragma once
+#include "IAsyncI2CController.hpp"
+#include "EEPROM24FC256.hpp"
+#include <cstdint>
+
+class AsyncPageWriter {
+public:
+    static constexpr uint8_t PAGE_SIZE = EEPROM24FC256::PAGE_SIZE;
+
+    /// Log region [startAddr, endAddr) of the EEPROM at deviceAddr, page aligned
+    /// (an odd startAddr is rounded up to the next sample boundary)
+    AsyncPageWriter(IAsyncI2CController& bus, uint8_t deviceAddr,
+                    uint16_t startAddr = 0,
+                    uint32_t endAddr = EEPROM24FC256::CAPACITY);
+
+    /**
+     * @brief Stage one Q12.4 sample; submits the page when it becomes full
+     * @return false if the sample could not be staged (both buffers busy)
+     */
+    bool Append(int16_t encoded);
+
+    /// Stage one temperature (same as Append(temp.Raw()))
+    bool Append(Temperature temp);
+
+    /**
+     * @brief Submit the staged-but-unwritten bytes of the current page
+     * @return false if no buffer was free or the bus queue was full
+     */
+    bool Flush();
+
+    /**
+     * @brief Main-loop service: ACK-poll for pages the device NACKed
+     *
+     * A NACKed page gets a zero-length ACK poll; the page write is
+     * resubmitted by the first Poll() after the device ACKed one.
+     *
+     * @return true when nothing is on the bus or waiting to be retried
+     */
+    bool Poll();
+
+    /// True when every staged byte has been written
+    bool IsIdle() const;
+
+    /// Page writes completed successfully
+    uint32_t GetPagesWritten() const;
+
+    /// Page writes the device NACKed (each is retried by Poll())
+    uint32_t GetRetries() const;
+
+    /// ACK polls submitted while waiting to retry a page
+    uint32_t GetAckPolls() const;
+
+private:
+    enum class State : uint8_t {
+        Staging,   ///< Owned by Append(); bytes [start, fill) not yet written
+        Idle,      ///< Free for the next page
+        InFlight,  ///< Submitted; owned by the bus until the callback
+        Retry,     ///< NACKed; Poll() sends an ACK poll
+        Polling,   ///< ACK poll in flight
+        Acked      ///< Device answered a poll; Poll() resubmits the page
+    };
+
+    struct Buffer {
+        uint8_t  addr[EEPROM24FC256::ADDRESS_BYTES];  ///< Header of the write
+        uint8_t  data[PAGE_SIZE];  ///< RAM image of the page
+        uint16_t pageBase;         ///< EEPROM address of data[0]
+        uint8_t  start;            ///< First byte not yet written
+        uint8_t  fill;             ///< Bytes staged
+        volatile State state;
+        I2CTransaction t;
+    };
+
+    IAsyncI2CController& m_bus;
+    uint8_t  m_deviceAddr;
+    uint16_t m_startAddr;
+    uint32_t m_endAddr;
+    Buffer   m_buffers[2];
+    uint8_t  m_active;  ///< Buffer being staged
+    volatile uint32_t m_pagesWritten;
+    volatile uint32_t m_retries;
+    uint32_t m_ackPolls;
+
+    /// Submit the active buffer and continue in the other one
+    bool Rotate();
+
+    /// Queue [start, fill) of b as one gathered write
+    bool Submit(Buffer& b);
+
+    /// Queue a zero-length write to the device (ACK poll) on b's transaction
+    bool SubmitPoll(Buffer& b);
+
+    /// True while b holds bytes not yet written (on the bus or to retry)
+    static bool Pending(State s);
+
+    /// Completion callback (interrupt context)
+    static void OnComplete(void* context, I2CTransaction& t);
+};
+
+// Inline implementations
+
+inline AsyncPageWriter::AsyncPageWriter(IAsyncI2CController& bus, uint8_t deviceAddr,
+                                        uint16_t startAddr, uint32_t endAddr)
+    : m_bus(bus), m_deviceAddr(deviceAddr),
+      m_startAddr(static_cast<uint16_t>(startAddr + (startAddr % EEPROM24FC256::BYTES_PER_SAMPLE))),
+      m_endAddr(endAddr),
+      m_buffers{}, m_active(0), m_pagesWritten(0), m_retries(0), m_ackPolls(0) {
+    // start/fill must stay even: Append() writes data[fill + 1]
+    uint16_t base = static_cast<uint16_t>(m_startAddr - (m_startAddr % PAGE_SIZE));
+    m_buffers[0].state = State::Staging;
+    m_buffers[0].pageBase = base;
+    m_buffers[0].start = static_cast<uint8_t>(m_startAddr - base);
+    m_buffers[0].fill = m_buffers[0].start;
+    m_buffers[1].state = State::Idle;
+}
+
+inline bool AsyncPageWriter::Append(Temperature temp) {
+    return Append(temp.Raw());
+}
+
+inline bool AsyncPageWriter::Append(int16_t encoded) {
+    // Page filled earlier but no buffer was free to continue in
+    if (m_buffers[m_active].fill == PAGE_SIZE && !Rotate()) {
+        return false;
+    }
+
+    Buffer& b = m_buffers[m_active];
+    b.data[b.fill]     = static_cast<uint8_t>((encoded >> 8) & 0xFF);
+    b.data[b.fill + 1] = static_cast<uint8_t>(encoded & 0xFF);
+    b.fill = static_cast<uint8_t>(b.fill + EEPROM24FC256::BYTES_PER_SAMPLE);
+
+    if (b.fill == PAGE_SIZE) {
+        Rotate();  // If not possible now, retried by the next Append()/Flush()
+    }
+    return true;
+}
+
+inline bool AsyncPageWriter::Flush() {
+    const Buffer& b = m_buffers[m_active];
+    if (b.start == b.fill) {
+        return true;  // Nothing new to write
+    }
+    return Rotate();
+}
+
+inline bool AsyncPageWriter::Rotate() {
+    Buffer& cur = m_buffers[m_active];
+    uint8_t nextIndex = static_cast<uint8_t>(m_active ^ 1);
+    Buffer& next = m_buffers[nextIndex];
+    if (next.state != State::Idle) {
+        return false;
+    }
+
+    // Continue the same page after a partial flush, else the next page
+    if (cur.fill == PAGE_SIZE) {
+        uint32_t following = static_cast<uint32_t>(cur.pageBase) + PAGE_SIZE;
+        if (following >= m_endAddr) {
+            next.pageBase = static_cast<uint16_t>(m_startAddr - (m_startAddr % PAGE_SIZE));
+            next.start = static_cast<uint8_t>(m_startAddr - next.pageBase);
+        } else {
+            next.pageBase = static_cast<uint16_t>(following);
+            next.start = 0;
+        }
+    } else {
+        next.pageBase = cur.pageBase;
+        next.start = cur.fill;
+    }
+    next.fill = next.start;
+
+    if (!Submit(cur)) {
+        return false;
+    }
+    next.state = State::Staging;
+    m_active = nextIndex;
+    return true;
+}
+
+inline bool AsyncPageWriter::Submit(Buffer& b) {
+    uint16_t memAddr = static_cast<uint16_t>(b.pageBase + b.start);
+    b.addr[0] = static_cast<uint8_t>(memAddr >> 8);
+    b.addr[1] = static_cast<uint8_t>(memAddr & 0xFF);
+
+    b.t.addr = m_deviceAddr;
+    b.t.header = b.addr;
+    b.t.headerLen = sizeof(b.addr);
+    b.t.data = &b.data[b.start];
+    b.t.dataLen = static_cast<size_t>(b.fill - b.start);
+    b.t.rx = nullptr;
+    b.t.rxLen = 0;
+    b.t.status = I2CStatus::Error;
+
+    // The callback can fire as soon as the transaction is queued
+    State previous = b.state;
+    b.state = State::InFlight;
+    if (!m_bus.Submit(b.t, &AsyncPageWriter::OnComplete, this)) {
+        b.state = previous;
+        return false;
+    }
+    return true;
+}
+
+inline bool AsyncPageWriter::SubmitPoll(Buffer& b) {
+    b.t.addr = m_deviceAddr;
+    b.t.header = nullptr;
+    b.t.headerLen = 0;
+    b.t.data = nullptr;
+    b.t.dataLen = 0;
+    b.t.rx = nullptr;
+    b.t.rxLen = 0;
+    b.t.status = I2CStatus::Error;
+
+    b.state = State::Polling;
+    if (!m_bus.Submit(b.t, &AsyncPageWriter::OnComplete, this)) {
+        b.state = State::Retry;
+        return false;
+    }
+    m_ackPolls++;
+    return true;
+}
+
+inline bool AsyncPageWriter::Pending(State s) {
+    return s == State::InFlight || s == State::Retry || s == State::Polling || s == State::Acked;
+}
+
+inline void AsyncPageWriter::OnComplete(void* context, I2CTransaction& t) {
+    AsyncPageWriter* self = static_cast<AsyncPageWriter*>(context);
+    Buffer& b = (&t == &self->m_buffers[0].t) ? self->m_buffers[0] : self->m_buffers[1];
+    if (b.state == State::Polling) {
+        // NACK: write cycle still running, Poll() sends the next poll
+        b.state = (t.status == I2CStatus::OK) ? State::Acked : State::Retry;
+    } else if (t.status == I2CStatus::OK) {
+        b.state = State::Idle;
+        self->m_pagesWritten = self->m_pagesWritten + 1;
+    } else {
+        b.state = State::Retry;
+        self->m_retries = self->m_retries + 1;
+    }
+}
+
+inline bool AsyncPageWriter::Poll() {
+    bool quiet = true;
+    for (uint8_t i = 0; i < 2; i++) {
+        Buffer& b = m_buffers[i];
+        // Queue full: the buffer keeps its state for the next Poll()
+        if (b.state == State::Retry) {
+            SubmitPoll(b);
+        } else if (b.state == State::Acked) {
+            Submit(b);
+        }
+        if (Pending(b.state)) {
+            quiet = false;
+        }
+    }
+
+    // A full page waiting for a free buffer moves on as soon as one is
+    const Buffer& cur = m_buffers[m_active];
+    if (cur.fill == PAGE_SIZE) {
+        Rotate();
+        quiet = false;
+    }
+    return quiet;
+}
+
+inline bool AsyncPageWriter::IsIdle() const {
+    for (uint8_t i = 0; i < 2; i++) {
+        if (Pending(m_buffers[i].state)) {
+            return false;
+        }
+    }
+    const Buffer& cur = m_buffers[m_active];
+    return cur.start == cur.fill;
+}
+
+inline uint32_t AsyncPageWriter::GetPagesWritten() const {
+    return m_pagesWritten;
+}
+
+inline uint32_t AsyncPageWriter::GetRetries() const {
+    return m_retries;
+}
+
+inline uint32_t AsyncPageWriter::GetAckPolls() const {
+    return m_ackPolls;
+}
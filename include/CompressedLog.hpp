@@ -0,0 +1,448 @@
+/**
+ * @file CompressedLog.hpp
+ * @brief Delta-compressed temperature log on top of EEPROM24FC256
+ *
+ * Samples taken every 10 minutes rarely move by more than a few 1/16 deg C
+ * steps, so storing every sample as a full 16-bit Q12.4 value wastes most
+ * of the EEPROM. This format stores one absolute value per page and
+ * nibble-packed deltas after it.
+ *
+ * Page layout (64 bytes, one page write per page):
+ *   [0]      sample count (0xFF = erased page, end of log)
+ *   [1..2]   sequence number, big-endian (wraps at 65536)
+ *   [3..4]   anchor: first sample of the page, Q12.4 big-endian
+ *   [5..63]  nibble stream, high nibble first (118 nibbles)
+ *
+ * Nibble codes for each following sample:
+ *   0x0-0x7, 0x9-0xF  delta to previous sample, 4-bit two's complement (-7..+7)
+ *   0x8               escape: next 4 nibbles hold the absolute Q12.4 value
+ *
+ * Every page decodes on its own (no dependency on earlier pages), so a
+ * damaged page loses at most 119 samples. Steady temperatures pack
+ * 119 samples per page versus 32 uncompressed (~3.7x retention).
+ *
+ * The log is a ring of pages. As in LogRing, consecutive pages carry
+ * consecutive sequence numbers, so a page left over from the previous lap
+ * (or from before a reset) does not continue the run: the reader wraps at
+ * the end of the ring and stops there. Recover() and SeekOldest() find
+ * the head with a binary search over page headers.
+ *
+ * Bus traffic: the page is staged in RAM and written once when full, so
+ * there is no per-sample transaction. Flush() writes a partial page.
+ */
+
+#pragma once
+#include "EEPROM24FC256.hpp"
+#include <cstdint>
+
+namespace CompressedLog {
+    static constexpr uint8_t  PAGE_SIZE       = EEPROM24FC256::PAGE_SIZE;
+    static constexpr uint8_t  HEADER_SIZE     = 5;
+    static constexpr uint8_t  PAYLOAD_NIBBLES = (PAGE_SIZE - HEADER_SIZE) * 2;
+    static constexpr uint8_t  MAX_SAMPLES     = 1 + PAYLOAD_NIBBLES;
+    static constexpr uint16_t DEVICE_PAGES    = EEPROM24FC256::CAPACITY / PAGE_SIZE;
+    static constexpr uint8_t  ERASED          = 0xFF;
+    static constexpr uint8_t  ESCAPE          = 0x8;
+    static constexpr int16_t  MAX_DELTA       = 7;
+
+    /// Position of the newest page of a ring, from its page headers
+    struct Head {
+        uint16_t index;    ///< Newest page, relative to the first page of the ring
+        uint16_t seq;      ///< Its sequence number
+        bool     empty;    ///< No valid page at the start of the ring
+        bool     wrapped;  ///< Older pages follow the head
+    };
+
+    /// Read sample count and sequence number of a page; valid is false for
+    /// an erased or never-written page
+    bool ReadHeader(EEPROM24FC256& eeprom, uint16_t page, uint16_t& seq, bool& valid);
+
+    /**
+     * @brief Locate the newest page of the ring [firstPage, firstPage + pageCount)
+     *
+     * Binary search for the last page whose sequence number continues the
+     * run started by the first page (same as LogRing::Recover()).
+     *
+     * @return false on I2C error
+     */
+    bool FindHead(EEPROM24FC256& eeprom, uint16_t firstPage, uint16_t pageCount, Head& head);
+}
+
+/// Streams samples into compressed pages
+class CompressedLogWriter {
+public:
+    /// Log occupies pages [firstPage, firstPage + pageCount), used as a ring
+    CompressedLogWriter(EEPROM24FC256& eeprom,
+                        uint16_t firstPage = 0,
+                        uint16_t pageCount = CompressedLog::DEVICE_PAGES);
+
+    /**
+     * @brief Continue an existing log after a reset
+     *
+     * Finds the newest page and opens the next one with the following
+     * sequence number. The newest page is not reloaded: samples after a
+     * reset start on a fresh page.
+     *
+     * @return false on I2C error
+     */
+    bool Recover();
+
+    /// Add one Q12.4 sample; writes the page when the next one is needed
+    /// Returns false if a page write failed (the sample is dropped)
+    bool Append(int16_t encoded);
+
+    /// Add one temperature (same as Append(temp.Raw()))
+    bool Append(Temperature temp);
+
+#ifndef TEMPLOGGER_NO_FLOAT
+    /// Add one temperature from degrees C (host-side)
+    bool Append(float temp);
+#endif
+
+    /// Write the partial current page so its samples survive a reset
+    bool Flush();
+
+    /// Page currently being filled
+    uint16_t GetCurrentPage() const;
+
+    /// Samples staged in the current page
+    uint8_t GetPageSamples() const;
+
+private:
+    EEPROM24FC256& m_eeprom;
+    uint16_t m_firstPage;
+    uint16_t m_pageCount;
+
+    uint8_t  m_page[CompressedLog::PAGE_SIZE];  ///< RAM image of current page
+    uint16_t m_pageIndex;  ///< Current page, relative to m_firstPage
+    uint16_t m_sequence;   ///< Sequence number of the current page
+    uint8_t  m_nibbles;    ///< Nibbles used in the payload
+    int16_t  m_last;       ///< Previous sample (delta base)
+    bool     m_dirty;      ///< Page image differs from EEPROM
+
+    void StartPage();
+    void PutNibble(uint8_t nibble);
+    bool WritePage();
+};
+
+/// Streaming decoder: returns samples one at a time, reading one page per
+/// bus transaction. Call SeekOldest() first once the ring may have wrapped.
+class CompressedLogReader {
+public:
+    /// Decode the ring [firstPage, firstPage + pageCount) from firstPage on,
+    /// wrapping at its end; stops at an erased page or one whose sequence
+    /// number does not follow the previous page (stale data)
+    CompressedLogReader(EEPROM24FC256& eeprom,
+                        uint16_t firstPage = 0,
+                        uint16_t pageCount = CompressedLog::DEVICE_PAGES);
+
+    /// Start at the oldest page of the ring (the one after the head if the
+    /// ring has wrapped); false on I2C error
+    bool SeekOldest();
+
+    /// Next sample in log order; false at end of log or on I2C error
+    bool Next(int16_t& encoded);
+
+    /// Pages read from the EEPROM so far
+    uint16_t GetPagesRead() const;
+
+private:
+    EEPROM24FC256& m_eeprom;
+    uint16_t m_firstPage;
+    uint16_t m_pageCount;
+
+    uint8_t  m_page[CompressedLog::PAGE_SIZE];
+    uint16_t m_start;      ///< First page to decode, relative to m_firstPage
+    uint16_t m_pagesRead;
+    uint16_t m_sequence;   ///< Sequence number of the last page read
+    uint8_t  m_remaining;  ///< Samples left in current page
+    uint8_t  m_nibbles;    ///< Next nibble in the payload
+    int16_t  m_last;
+    bool     m_ended;
+
+    bool LoadPage();
+    uint8_t GetNibble();
+};
+
+// Inline implementations: page headers
+
+inline bool CompressedLog::ReadHeader(EEPROM24FC256& eeprom, uint16_t page, uint16_t& seq, bool& valid) {
+    uint8_t hdr[3];
+    if (!eeprom.ReadBytes(static_cast<uint16_t>(page * PAGE_SIZE), hdr, sizeof(hdr))) {
+        return false;
+    }
+    seq = static_cast<uint16_t>((hdr[1] << 8) | hdr[2]);
+    valid = (hdr[0] != 0 && hdr[0] <= MAX_SAMPLES);  // 0xFF: erased
+    return true;
+}
+
+inline bool CompressedLog::FindHead(EEPROM24FC256& eeprom, uint16_t firstPage, uint16_t pageCount,
+                                    Head& head) {
+    uint16_t seq0 = 0;
+    bool valid = false;
+    head.index = 0;
+    head.seq = 0;
+    head.empty = true;
+    head.wrapped = false;
+
+    if (!ReadHeader(eeprom, firstPage, seq0, valid)) {
+        return false;
+    }
+    if (!valid) {
+        return true;
+    }
+
+    // Last page p with seq(p) == seq(0) + p; holds for 0 and fails past the head
+    uint16_t lo = 0;
+    uint16_t hi = static_cast<uint16_t>(pageCount - 1);
+    while (lo < hi) {
+        uint16_t mid = static_cast<uint16_t>((lo + hi + 1) / 2);
+        uint16_t seq = 0;
+        if (!ReadHeader(eeprom, static_cast<uint16_t>(firstPage + mid), seq, valid)) {
+            return false;
+        }
+        if (valid && static_cast<uint16_t>(seq - seq0) == mid) {
+            lo = mid;
+        } else {
+            hi = static_cast<uint16_t>(mid - 1);
+        }
+    }
+
+    // Older data follows the head if the next page holds a valid header
+    if (lo + 1 < pageCount) {
+        uint16_t seq = 0;
+        if (!ReadHeader(eeprom, static_cast<uint16_t>(firstPage + lo + 1), seq, valid)) {
+            return false;
+        }
+        head.wrapped = valid;
+    }
+    head.index = lo;
+    head.seq = static_cast<uint16_t>(seq0 + lo);
+    head.empty = false;
+    return true;
+}
+
+// Inline implementations: writer
+
+inline CompressedLogWriter::CompressedLogWriter(EEPROM24FC256& eeprom,
+                                                uint16_t firstPage,
+                                                uint16_t pageCount)
+    : m_eeprom(eeprom), m_firstPage(firstPage), m_pageCount(pageCount),
+      m_page{}, m_pageIndex(0), m_sequence(0), m_nibbles(0), m_last(0), m_dirty(false) {
+    StartPage();
+}
+
+inline bool CompressedLogWriter::Recover() {
+    CompressedLog::Head head;
+    if (!CompressedLog::FindHead(m_eeprom, m_firstPage, m_pageCount, head)) {
+        return false;
+    }
+    if (head.empty) {
+        m_pageIndex = 0;
+        m_sequence = 0;
+    } else {
+        m_pageIndex = static_cast<uint16_t>((head.index + 1) % m_pageCount);
+        m_sequence = static_cast<uint16_t>(head.seq + 1);
+    }
+    StartPage();
+    return true;
+}
+
+inline void CompressedLogWriter::StartPage() {
+    for (uint8_t i = 0; i < CompressedLog::PAGE_SIZE; i++) {
+        m_page[i] = CompressedLog::ERASED;
+    }
+    m_page[0] = 0;  // Sample count
+    m_page[1] = static_cast<uint8_t>(m_sequence >> 8);
+    m_page[2] = static_cast<uint8_t>(m_sequence & 0xFF);
+    m_nibbles = 0;
+    m_dirty = false;
+}
+
+inline void CompressedLogWriter::PutNibble(uint8_t nibble) {
+    uint8_t& b = m_page[CompressedLog::HEADER_SIZE + m_nibbles / 2];
+    if ((m_nibbles & 1) == 0) {
+        b = static_cast<uint8_t>((b & 0x0F) | (nibble << 4));
+    } else {
+        b = static_cast<uint8_t>((b & 0xF0) | (nibble & 0x0F));
+    }
+    m_nibbles++;
+}
+
+inline bool CompressedLogWriter::WritePage() {
+    uint16_t addr = static_cast<uint16_t>((m_firstPage + m_pageIndex) * CompressedLog::PAGE_SIZE);
+    if (!m_eeprom.WritePage(addr, m_page, CompressedLog::PAGE_SIZE)) {
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+inline bool CompressedLogWriter::Append(Temperature temp) {
+    return Append(temp.Raw());
+}
+
+#ifndef TEMPLOGGER_NO_FLOAT
+inline bool CompressedLogWriter::Append(float temp) {
+    return Append(EEPROM24FC256::EncodeTemperature(temp));
+}
+#endif
+
+inline bool CompressedLogWriter::Append(int16_t encoded) {
+    uint8_t count = m_page[0];
+
+    if (count > 0) {
+        int32_t delta = static_cast<int32_t>(encoded) - m_last;
+        bool small = (delta >= -CompressedLog::MAX_DELTA && delta <= CompressedLog::MAX_DELTA);
+        uint8_t needed = small ? 1 : 5;
+
+        if (count < CompressedLog::MAX_SAMPLES &&
+            m_nibbles + needed <= CompressedLog::PAYLOAD_NIBBLES) {
+            if (small) {
+                PutNibble(static_cast<uint8_t>(delta & 0x0F));
+            } else {
+                uint16_t raw = static_cast<uint16_t>(encoded);
+                PutNibble(CompressedLog::ESCAPE);
+                PutNibble(static_cast<uint8_t>((raw >> 12) & 0x0F));
+                PutNibble(static_cast<uint8_t>((raw >> 8) & 0x0F));
+                PutNibble(static_cast<uint8_t>((raw >> 4) & 0x0F));
+                PutNibble(static_cast<uint8_t>(raw & 0x0F));
+            }
+            m_page[0] = static_cast<uint8_t>(count + 1);
+            m_last = encoded;
+            m_dirty = true;
+            return true;
+        }
+
+        // Page full: write it out and start the next one with this sample
+        if (m_dirty && !WritePage()) {
+            return false;
+        }
+        m_pageIndex = static_cast<uint16_t>((m_pageIndex + 1) % m_pageCount);
+        m_sequence++;
+        StartPage();
+    }
+
+    // First sample of a page is stored as the absolute anchor
+    m_page[0] = 1;
+    m_page[3] = static_cast<uint8_t>((encoded >> 8) & 0xFF);
+    m_page[4] = static_cast<uint8_t>(encoded & 0xFF);
+    m_last = encoded;
+    m_dirty = true;
+    return true;
+}
+
+inline bool CompressedLogWriter::Flush() {
+    if (!m_dirty) {
+        return true;
+    }
+    return WritePage();
+}
+
+inline uint16_t CompressedLogWriter::GetCurrentPage() const {
+    return static_cast<uint16_t>(m_firstPage + m_pageIndex);
+}
+
+inline uint8_t CompressedLogWriter::GetPageSamples() const {
+    return m_page[0];
+}
+
+// Inline implementations: reader
+
+inline CompressedLogReader::CompressedLogReader(EEPROM24FC256& eeprom,
+                                                uint16_t firstPage,
+                                                uint16_t pageCount)
+    : m_eeprom(eeprom), m_firstPage(firstPage), m_pageCount(pageCount),
+      m_page{}, m_start(0), m_pagesRead(0), m_sequence(0), m_remaining(0), m_nibbles(0),
+      m_last(0), m_ended(false) {
+}
+
+inline bool CompressedLogReader::SeekOldest() {
+    CompressedLog::Head head;
+    if (!CompressedLog::FindHead(m_eeprom, m_firstPage, m_pageCount, head)) {
+        return false;
+    }
+    m_start = head.wrapped ? static_cast<uint16_t>((head.index + 1) % m_pageCount) : 0;
+    m_pagesRead = 0;
+    m_remaining = 0;
+    m_ended = false;
+    return true;
+}
+
+inline bool CompressedLogReader::LoadPage() {
+    if (m_pagesRead >= m_pageCount) {
+        return false;
+    }
+
+    // Same ring as the writer: wrap at the end of the region
+    uint16_t page = static_cast<uint16_t>(m_firstPage + (m_start + m_pagesRead) % m_pageCount);
+    if (!m_eeprom.ReadBytes(static_cast<uint16_t>(page * CompressedLog::PAGE_SIZE),
+                            m_page, CompressedLog::PAGE_SIZE)) {
+        return false;
+    }
+    m_pagesRead++;
+
+    uint8_t count = m_page[0];
+    if (count == CompressedLog::ERASED || count == 0 || count > CompressedLog::MAX_SAMPLES) {
+        return false;  // Erased or never-written page: end of log
+    }
+
+    // A page that does not continue the sequence is left from an older lap
+    uint16_t seq = static_cast<uint16_t>((m_page[1] << 8) | m_page[2]);
+    if (m_pagesRead > 1 && seq != static_cast<uint16_t>(m_sequence + 1)) {
+        return false;
+    }
+    m_sequence = seq;
+
+    m_remaining = count;
+    m_nibbles = 0;
+    return true;
+}
+
+inline uint8_t CompressedLogReader::GetNibble() {
+    uint8_t b = m_page[CompressedLog::HEADER_SIZE + m_nibbles / 2];
+    uint8_t nibble = ((m_nibbles & 1) == 0) ? (b >> 4) : (b & 0x0F);
+    m_nibbles++;
+    return nibble;
+}
+
+inline bool CompressedLogReader::Next(int16_t& encoded) {
+    if (m_ended) {
+        return false;
+    }
+
+    if (m_remaining == 0) {
+        if (!LoadPage()) {
+            m_ended = true;
+            return false;
+        }
+
+        // Anchor sample
+        m_last = static_cast<int16_t>((static_cast<uint16_t>(m_page[3]) << 8) | m_page[4]);
+        m_remaining--;
+        encoded = m_last;
+        return true;
+    }
+
+    uint8_t nibble = GetNibble();
+    if (nibble == CompressedLog::ESCAPE) {
+        uint16_t raw = 0;
+        for (int i = 0; i < 4; i++) {
+            raw = static_cast<uint16_t>((raw << 4) | GetNibble());
+        }
+        m_last = static_cast<int16_t>(raw);
+    } else {
+        // Sign-extend the 4-bit delta
+        int16_t delta = (nibble & 0x8) ? static_cast<int16_t>(nibble) - 16
+                                       : static_cast<int16_t>(nibble);
+        m_last = static_cast<int16_t>(m_last + delta);
+    }
+
+    m_remaining--;
+    encoded = m_last;
+    return true;
+}
+
+inline uint16_t CompressedLogReader::GetPagesRead() const {
+    return m_pagesRead;
+}
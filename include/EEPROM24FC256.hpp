@@ -2,152 +2,12 @@
  * @file EEPROM24FC256.hpp
  * @brief 24FC256 EEPROM driver (32KB, I2C)
  * 
- * Specs: 32,768 bytes, 64-byte pages, 5ms write cycle
+ * Specs: 32,768 bytes, 64-byte pages, 2 address bytes, 5ms write cycle
  * 
- * Uses: Fixed-point Q12.4 encoding (2 bytes per sample), ACK polling for write detection
- * 
- * Datasheet Compliance:
- * - Implements byte write (current approach: 1 write per 10 min logging interval)
- * - Implements ACK polling for write cycle detection (Section 4.5)
- * - Checks page boundaries to prevent accidental data wrapping (Section 6.2)
- * - Future optimization: Could use page write (up to 64 bytes) for bulk transfers
+ * The driver is the EEPROM24xx template instantiated for this geometry;
+ * the log formats built on it (EEPROMPageWriter, CompressedLog, LogRing,
+ * EEPROMVolume) include this header and keep using the EEPROM24FC256 name.
  */
 
 #pragma once
-#include "II2CController.hpp"
-#include <cstdint>
-
-class EEPROM24FC256 {
-public:
-/// Constructor takes I2C controller and device address
-    EEPROM24FC256(II2CController& i2c, uint8_t address);
-    
-    /// Write temperature to EEPROM using fixed-point Q12.4 encoding
-    /// Returns false on I2C error or write timeout
-    bool LogData(uint16_t memAddr, float temp);
-    
-    /// Read temperature from EEPROM and decode (returns -999.0f on error)
-    float ReadData(uint16_t memAddr);
-
-private:
-    static constexpr uint32_t CAPACITY = 32768;
-    static constexpr uint8_t  PAGE_SIZE = 64;
-    static constexpr uint8_t  WRITE_CYCLE_MS_MAX = 5;
-    
-    II2CController& m_i2c;  ///< Reference to I2C bus controller
-    uint8_t m_address;      ///< 7-bit I2C device address
-    
-    /**
-     * @brief Wait for internal write cycle to complete using ACK polling
-     * 
-     * How ACK polling works (from 24FC256 datasheet):
-     * 1. During internal write cycle, device will NOT acknowledge its address
-     * 2. After write completes, device will acknowledge normally
-     * 3. By repeatedly sending address and checking for ACK, we detect completion
-     * 
-     * Why ACK polling instead of fixed delay?
-     * - Optimal performance: returns immediately when write completes (3ms typical)
-     * - Reliable: guaranteed to wait long enough (vs fixed 5ms might be too short)
-     * - Standard practice: recommended by datasheet
-     * 
-     * Alternative approach (not used):
-     * - Fixed delay: delay_ms(5); // Simple but wastes time
-     * 
-     * Implementation:
-     * - Send write address (0 bytes of data)
-     * - If ACK received → write complete
-     * - If NACK received → still busy, try again
-     * - Timeout after ~10ms (2× max write time) to prevent infinite loop
-     */
-    void WaitForWriteComplete();
-    
-    // Encoding: multiply by 16 (LSB = 0.0625°C)
-    static int16_t EncodeTemperature(float temp);
-    static float DecodeTemperature(int16_t encoded);
-};
-
-// Inline implementations
-
-inline EEPROM24FC256::EEPROM24FC256(II2CController& i2c, uint8_t address)
-    : m_i2c(i2c), m_address(address) {
-}
-
-inline int16_t EEPROM24FC256::EncodeTemperature(float temp) {
-    return static_cast<int16_t>(temp * 16.0f);
-}
-
-inline float EEPROM24FC256::DecodeTemperature(int16_t encoded) {
-    return static_cast<float>(encoded) / 16.0f;
-}
-
-inline bool EEPROM24FC256::LogData(uint16_t memAddr, float temp) {
-    // Check that write doesn't exceed EEPROM capacity
-    if (static_cast<uint32_t>(memAddr) + 2 > CAPACITY) {
-        return false;  // Would write past end of EEPROM
-    }
-    
-    // Check for page boundary crossing (64-byte pages)
-    // Per datasheet Section 6.2: If address counter exceeds page boundary,
-    // it wraps to beginning of same page (data corruption)
-    // However, at end of EEPROM this is acceptable since we stop writing anyway
-    uint16_t pageNumber = memAddr / PAGE_SIZE;
-    uint16_t endAddr = memAddr + 2;
-    uint16_t nextPageNumber = endAddr / PAGE_SIZE;
-    
-    // Only reject if crossing a page boundary BEFORE the last page
-    if ((pageNumber != nextPageNumber) && (endAddr < CAPACITY)) {
-        // Would cross page boundary mid-EEPROM - this would wrap data
-        // For this application, just reject the write (fail safely)
-        return false;
-    }
-    
-    int16_t encoded = EncodeTemperature(temp);
-    
-    uint8_t payload[4] = {
-        static_cast<uint8_t>((memAddr >> 8) & 0xFF),
-        static_cast<uint8_t>(memAddr & 0xFF),
-        static_cast<uint8_t>((encoded >> 8) & 0xFF),
-        static_cast<uint8_t>(encoded & 0xFF)
-    };
-    
-    if (m_i2c.Write(m_address, payload, sizeof(payload)) != I2CStatus::OK) {
-        return false;
-    }
-    
-    WaitForWriteComplete();
-    return true;
-}
-
-inline float EEPROM24FC256::ReadData(uint16_t memAddr) {
-    if (memAddr >= CAPACITY - 1) {
-        return -999.0f;
-    }
-    
-    uint8_t addrBytes[2] = {
-        static_cast<uint8_t>((memAddr >> 8) & 0xFF),
-        static_cast<uint8_t>(memAddr & 0xFF)
-    };
-    
-    uint8_t data[2] = {0, 0};
-    I2CStatus status = m_i2c.WriteRead(m_address, addrBytes, 2, data, 2);
-    
-    if (status != I2CStatus::OK) {
-        return -999.0f;
-    }
-    
-    int16_t encoded = (static_cast<int16_t>(data[0]) << 8) | data[1];
-    return DecodeTemperature(encoded);
-}
-
-inline void EEPROM24FC256::WaitForWriteComplete() {
-    const int maxAttempts = 100;
-    
-    for (int attempt = 0; attempt < maxAttempts; attempt++) {
-        if (m_i2c.Write(m_address, nullptr, 0) == I2CStatus::OK) {
-            return;  // Device acknowledged - write complete
-        }
-        
-        // Wait ~100μs before next attempt
-        for (volatile int i = 0; i < 1000; i++) {}
-    }
-}
+#include "EEPROM24xx.hpp"
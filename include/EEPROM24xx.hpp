@@ -0,0 +1,684 @@
+/**
+ * @file EEPROM24xx.hpp
+ * @brief 24xx-series I2C EEPROM driver, parameterized on device geometry
+ * 
+ * Template parameters describe the part:
+ * - Capacity:     bytes, power of two (8192 for 24LC64, 32768 for 24FC256)
+ * - PageSize:     page write buffer, power of two (32 / 64 / 128 bytes)
+ * - AddrBytes:    memory address bytes sent after the control byte (1 or 2)
+ * - WriteCycleMs: max internal write cycle time, sizes the ACK poll budget
+ * - Bus:          I2C controller type (default II2CController)
+ * 
+ * All page and capacity math uses shifts and masks derived from these at
+ * compile time; no part pays at runtime for the driver being generic.
+ * EEPROM24FC256 (see EEPROM24FC256.hpp) is one instantiation.
+ * 
+ * Bus binding: with the default, every transaction is a virtual call
+ * through II2CController, so one driver type serves any controller (and
+ * the test mocks). Instantiated over a concrete final controller (e.g.
+ * EEPROM24FC256T<MockI2C>) the calls bind statically and the compiler can
+ * inline the whole transaction path.
+ * 
+ * Uses: Fixed-point Q12.4 encoding (2 bytes per sample), ACK polling for write detection
+ * 
+ * Datasheet Compliance:
+ * - Implements byte write (current approach: 1 write per 10 min logging interval)
+ * - Implements ACK polling for write cycle detection (Section 4.5),
+ *   blocking or deferred via Poll() in async mode
+ * - Checks page boundaries to prevent accidental data wrapping (Section 6.2)
+ * - Implements page write (up to PAGE_SIZE bytes per write cycle, Section 6.2)
+ *   used by EEPROMPageWriter to batch samples
+ */
+
+#pragma once
+#include "II2CController.hpp"
+#include "Temperature.hpp"
+#include <cstdint>
+
+namespace EEPROM24xxDetail {
+    /// log2 of a power of two, evaluated at compile time
+    constexpr uint8_t Log2(uint32_t value) {
+        return (value <= 1) ? 0 : static_cast<uint8_t>(1 + Log2(value >> 1));
+    }
+    
+    constexpr bool IsPowerOfTwo(uint32_t value) {
+        return value != 0 && (value & (value - 1)) == 0;
+    }
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs,
+          typename Bus = II2CController>
+class EEPROM24xx {
+    static_assert(EEPROM24xxDetail::IsPowerOfTwo(Capacity), "Capacity must be a power of two");
+    static_assert(EEPROM24xxDetail::IsPowerOfTwo(PageSize), "PageSize must be a power of two");
+    static_assert(PageSize <= 128 && PageSize <= Capacity, "PageSize must fit uint8_t lengths and the device");
+    static_assert(AddrBytes == 1 || AddrBytes == 2, "24xx parts use 1 or 2 address bytes");
+    static_assert(Capacity <= (1UL << (8 * AddrBytes)), "Capacity exceeds the address width");
+    static_assert(WriteCycleMs > 0, "Write cycle time must be non-zero");
+    static_assert(AddrBytes + PageSize <= II2CController::WRITEV_STAGING, "Page write must fit the default WriteV staging");
+
+public:
+    static constexpr uint32_t CAPACITY = Capacity;
+    static constexpr uint8_t  PAGE_SIZE = static_cast<uint8_t>(PageSize);
+    static constexpr uint8_t  ADDRESS_BYTES = AddrBytes;
+    static constexpr uint8_t  WRITE_CYCLE_MS_MAX = WriteCycleMs;
+    static constexpr uint8_t  BYTES_PER_SAMPLE = 2;
+    
+    static constexpr uint8_t  PAGE_SHIFT = EEPROM24xxDetail::Log2(PageSize);
+    static constexpr uint16_t PAGE_MASK = static_cast<uint16_t>(PageSize - 1);
+    static constexpr uint32_t PAGE_COUNT = Capacity >> PAGE_SHIFT;
+    
+    // 12-bit packed layout: PAGE_SIZE / 3 sample pairs (3 bytes each) per
+    // page, trailing bytes unused so no pair straddles a page boundary
+    static constexpr uint8_t  PACKED12_SAMPLES_PER_PAGE = (PAGE_SIZE / 3) * 2;
+    static constexpr uint16_t PACKED12_CAPACITY =
+        static_cast<uint16_t>(PAGE_COUNT * PACKED12_SAMPLES_PER_PAGE);
+
+/// Constructor takes I2C controller and device address
+    EEPROM24xx(Bus& i2c, uint8_t address);
+    
+    /// Write temperature to EEPROM using fixed-point Q12.4 encoding
+    /// Returns false on I2C error or write timeout
+    bool LogData(uint16_t memAddr, Temperature temp);
+    
+    /// Read a temperature written by LogData(); false on I2C error
+    bool ReadData(uint16_t memAddr, Temperature& temp);
+    
+#ifndef TEMPLOGGER_NO_FLOAT
+    /// Host-side: LogData() from degrees C
+    bool LogData(uint16_t memAddr, float temp);
+    
+    /// Host-side: read and decode (returns -999.0f on error)
+    float ReadData(uint16_t memAddr);
+#endif
+    
+    /**
+     * @brief Write up to one page of raw bytes in a single write cycle
+     * 
+     * Transaction: [address bytes][data 0..len-1] as one gathered
+     * II2CController::WriteV() (data is not copied), then ACK polling
+     * (deferred to Poll() or the next access in async mode).
+     * The range must stay inside one PAGE_SIZE page; the device would
+     * otherwise wrap to the start of the same page (Section 6.2).
+     * 
+     * @return false on bad range, I2C error or write timeout
+     */
+    bool WritePage(uint16_t memAddr, const uint8_t* data, uint8_t len);
+    
+    /**
+     * @brief Sequential read of raw bytes (Section 8.3)
+     * 
+     * Address is sent once, then the device streams bytes with its
+     * internal address counter, so any length up to CAPACITY costs a
+     * single bus transaction. Range must not run past the end of memory.
+     * 
+     * @return false on bad range or I2C error
+     */
+    bool ReadBytes(uint16_t memAddr, uint8_t* data, uint32_t len);
+    
+    /**
+     * @brief Bulk read of Q12.4 samples from the circular log
+     * 
+     * Reads count consecutive 2-byte samples starting at startAddr. If the
+     * range runs past the end of the EEPROM it continues at address 0 (the
+     * ring used by main.cpp), costing one extra transaction. Samples are
+     * decoded in place in out[], no staging buffer is needed.
+     * 
+     * @param startAddr Even address of the first sample
+     * @param out Destination for count encoded samples
+     * @param count Number of samples (at most CAPACITY / 2)
+     * @return false on bad range or I2C error
+     */
+    bool ReadRange(uint16_t startAddr, int16_t* out, uint16_t count);
+    
+    /**
+     * @brief Write Q12.4 samples in the 12-bit packed layout
+     * 
+     * The TMP100 only delivers 12 significant bits, so two samples fit in
+     * three bytes: [a11..a4][a3..a0 b11..b8][b7..b0]. On the 24FC256 that
+     * is 42 samples per page (21504 per device) instead of 32 (16384),
+     * with no loss of precision.
+     * 
+     * One page write per page touched. A run starting on an odd slot or
+     * ending on an even slot shares a byte with its neighbour sample, which
+     * is read back first so the neighbour is preserved.
+     * 
+     * @param sampleIndex Packed slot of samples[0] (0..PACKED12_CAPACITY-1)
+     * @param samples Q12.4 values, each within 12 bits (-2048..2047)
+     * @return false on bad range, out-of-range sample or I2C error
+     */
+    bool WritePacked12(uint16_t sampleIndex, const int16_t* samples, uint16_t count);
+    
+    /**
+     * @brief Read Q12.4 samples stored in the 12-bit packed layout
+     * 
+     * Single sequential read of the packed bytes into out[], unpacked
+     * in place (packed data is always smaller than the decoded samples).
+     * 
+     * @return false on bad range or I2C error
+     */
+    bool ReadPacked12(uint16_t sampleIndex, int16_t* out, uint16_t count);
+    
+    /**
+     * @brief Enable/disable asynchronous write cycles
+     * 
+     * Blocking (default): every write returns after ACK polling has seen the
+     * internal write cycle finish.
+     * Asynchronous: a write returns as soon as the device has accepted the
+     * data. The write cycle is tracked as in flight and finished by Poll(),
+     * or by a blocking wait before the next bus access to this device.
+     */
+    void SetAsyncWrites(bool enable);
+    
+    /// Send one ACK poll if a write cycle is in flight
+    /// Returns true when the device is idle (no write cycle pending)
+    bool Poll();
+    
+    /// True while an asynchronous write cycle has not been seen to finish
+    bool IsBusy() const;
+    
+    /// One cached page, storage owned by the caller
+    struct CacheLine {
+        uint16_t page;              ///< Page number held in data[]
+        bool     valid;
+        uint8_t  data[PageSize];
+    };
+    
+    /**
+     * @brief Serve small reads from caller-provided page-sized lines
+     * 
+     * A read that stays inside one page is answered from RAM if the page
+     * is cached; on a miss the whole page is read with one transaction
+     * and replaces the oldest line (round robin). Reads spanning pages
+     * bypass the cache - they are already a single sequential read.
+     * 
+     * Writes are write-through: WritePage() (and LogData()) update a
+     * cached copy of the page once the device has accepted the data, and
+     * drop it if the write fails. A hit never waits for a write cycle.
+     * 
+     * @param lines Cache storage, or nullptr to detach the cache
+     * @param count Number of lines (1 to a few pages is typical)
+     */
+    void AttachReadCache(CacheLine* lines, uint8_t count);
+    
+    /// Reads answered from the cache
+    uint32_t GetCacheHits() const;
+    
+    /// Reads that had to fetch a page from the device
+    uint32_t GetCacheMisses() const;
+    
+    /// Zero the hit/miss counters
+    void ResetCacheStats();
+    
+#ifndef TEMPLOGGER_NO_FLOAT
+    // Host-side encoding: multiply by 16 (LSB = 0.0625°C), see Temperature
+    static int16_t EncodeTemperature(float temp);
+    static float DecodeTemperature(int16_t encoded);
+#endif
+
+private:
+    Bus& m_i2c;             ///< I2C bus (concrete type or the II2CController adapter)
+    uint8_t m_address;      ///< 7-bit I2C device address
+    bool m_asyncWrites;     ///< Return from writes before the write cycle ends
+    bool m_writePending;    ///< Write cycle started but not yet seen to finish
+    
+    CacheLine* m_cache;     ///< Read cache lines (nullptr = no cache)
+    uint8_t m_cacheLines;
+    uint8_t m_cacheNext;    ///< Line replaced on the next miss
+    uint32_t m_cacheHits;
+    uint32_t m_cacheMisses;
+    
+    /// Sequential read from the device, after any pending write cycle
+    bool ReadDevice(uint16_t memAddr, uint8_t* data, uint32_t len);
+    
+    /// Read inside one page through the cache
+    bool ReadCached(uint16_t memAddr, uint8_t* data, uint32_t len);
+    
+    /// Cached line holding page, or nullptr
+    CacheLine* FindLine(uint16_t page) const;
+    
+    /**
+     * @brief Wait for internal write cycle to complete using ACK polling
+     * 
+     * How ACK polling works (from 24FC256 datasheet):
+     * 1. During internal write cycle, device will NOT acknowledge its address
+     * 2. After write completes, device will acknowledge normally
+     * 3. By repeatedly sending address and checking for ACK, we detect completion
+     * 
+     * Why ACK polling instead of fixed delay?
+     * - Optimal performance: returns immediately when write completes (3ms typical)
+     * - Reliable: guaranteed to wait long enough (vs fixed 5ms might be too short)
+     * - Standard practice: recommended by datasheet
+     * 
+     * Alternative approach (not used):
+     * - Fixed delay: delay_ms(5); // Simple but wastes time
+     * 
+     * Implementation:
+     * - Send write address (0 bytes of data)
+     * - If ACK received → write complete
+     * - If NACK received → still busy, try again
+     * - Timeout after ~2× WRITE_CYCLE_MS_MAX to prevent infinite loop
+     * 
+     * The write stays pending until the device ACKs, so after a timeout
+     * the next access waits again instead of talking to a busy device.
+     * 
+     * @return false on timeout (device never acknowledged)
+     */
+    bool WaitForWriteComplete();
+    
+    /// Byte address of a packed 12-bit sample (first of its two bytes)
+    static uint16_t Packed12Address(uint16_t sampleIndex);
+    
+    /// Store memAddr as ADDRESS_BYTES big-endian bytes; returns bytes written
+    static uint8_t PutAddress(uint8_t* buf, uint16_t memAddr);
+};
+
+// Inline implementations
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::EEPROM24xx(Bus& i2c, uint8_t address)
+    : m_i2c(i2c), m_address(address), m_asyncWrites(false), m_writePending(false),
+      m_cache(nullptr), m_cacheLines(0), m_cacheNext(0), m_cacheHits(0), m_cacheMisses(0) {
+}
+
+#ifndef TEMPLOGGER_NO_FLOAT
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline int16_t EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::EncodeTemperature(float temp) {
+    return Temperature::FromFloat(temp).Raw();
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline float EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::DecodeTemperature(int16_t encoded) {
+    return Temperature::FromRaw(encoded).ToFloat();
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::LogData(uint16_t memAddr, float temp) {
+    return LogData(memAddr, Temperature::FromFloat(temp));
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline float EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::ReadData(uint16_t memAddr) {
+    Temperature temp;
+    if (!ReadData(memAddr, temp)) {
+        return -999.0f;
+    }
+    return temp.ToFloat();
+}
+#endif
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::LogData(uint16_t memAddr, Temperature temp) {
+    int16_t encoded = temp.Raw();
+    
+    uint8_t data[BYTES_PER_SAMPLE] = {
+        static_cast<uint8_t>((encoded >> 8) & 0xFF),
+        static_cast<uint8_t>(encoded & 0xFF)
+    };
+    
+    return WritePage(memAddr, data, sizeof(data));
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::WritePage(uint16_t memAddr, const uint8_t* data, uint8_t len) {
+    // Check that write doesn't exceed EEPROM capacity
+    if (len == 0 || static_cast<uint32_t>(memAddr) + len > CAPACITY) {
+        return false;  // Would write past end of EEPROM
+    }
+    
+    // Check for page boundary crossing (PAGE_SIZE-byte pages)
+    // Per datasheet Section 6.2: If address counter exceeds page boundary,
+    // it wraps to beginning of same page (data corruption)
+    // For this application, just reject the write (fail safely)
+    if ((memAddr & PAGE_MASK) + len > PAGE_SIZE) {
+        return false;
+    }
+    
+    // Previous write cycle must finish before the device accepts new data
+    if (m_writePending && !WaitForWriteComplete()) {
+        return false;
+    }
+    
+    // Address bytes and caller data go out as one gathered write (no copy)
+    uint8_t addrBytes[ADDRESS_BYTES];
+    uint8_t header = PutAddress(addrBytes, memAddr);
+    
+    CacheLine* line = FindLine(static_cast<uint16_t>(memAddr >> PAGE_SHIFT));
+    if (m_i2c.WriteV(m_address, addrBytes, header, data, len) != I2CStatus::OK) {
+        if (line != nullptr) {
+            line->valid = false;  // Device contents now unknown
+        }
+        return false;
+    }
+    
+    // Write-through: keep the cached copy equal to the device
+    if (line != nullptr) {
+        for (uint8_t i = 0; i < len; i++) {
+            line->data[(memAddr & PAGE_MASK) + i] = data[i];
+        }
+    }
+    
+    m_writePending = true;
+    if (!m_asyncWrites) {
+        return WaitForWriteComplete();
+    }
+    return true;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::ReadData(uint16_t memAddr, Temperature& temp) {
+    uint8_t data[BYTES_PER_SAMPLE] = {0, 0};
+    
+    if (!ReadBytes(memAddr, data, sizeof(data))) {
+        return false;
+    }
+    
+    temp = Temperature::FromRaw(static_cast<int16_t>((data[0] << 8) | data[1]));
+    return true;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::ReadBytes(uint16_t memAddr, uint8_t* data, uint32_t len) {
+    if (len == 0 || static_cast<uint32_t>(memAddr) + len > CAPACITY) {
+        return false;
+    }
+    
+    if (m_cacheLines > 0 && (memAddr & PAGE_MASK) + len <= PAGE_SIZE) {
+        return ReadCached(memAddr, data, len);
+    }
+    return ReadDevice(memAddr, data, len);
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::ReadDevice(uint16_t memAddr, uint8_t* data, uint32_t len) {
+    // Device ignores reads until its write cycle has finished
+    if (m_writePending && !WaitForWriteComplete()) {
+        return false;
+    }
+    
+    uint8_t addrBytes[ADDRESS_BYTES];
+    uint8_t header = PutAddress(addrBytes, memAddr);
+    
+    return m_i2c.WriteRead(m_address, addrBytes, header, data, len) == I2CStatus::OK;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::ReadCached(uint16_t memAddr, uint8_t* data, uint32_t len) {
+    uint16_t page = static_cast<uint16_t>(memAddr >> PAGE_SHIFT);
+    CacheLine* line = FindLine(page);
+    
+    if (line != nullptr) {
+        m_cacheHits++;
+    } else {
+        m_cacheMisses++;
+        line = &m_cache[m_cacheNext];
+        if (++m_cacheNext == m_cacheLines) {
+            m_cacheNext = 0;  // Round robin without a runtime division
+        }
+        
+        line->valid = false;
+        if (!ReadDevice(static_cast<uint16_t>(page << PAGE_SHIFT), line->data, PAGE_SIZE)) {
+            return false;
+        }
+        line->page = page;
+        line->valid = true;
+    }
+    
+    const uint8_t* src = &line->data[memAddr & PAGE_MASK];
+    for (uint32_t i = 0; i < len; i++) {
+        data[i] = src[i];
+    }
+    return true;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline typename EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::CacheLine*
+EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::FindLine(uint16_t page) const {
+    for (uint8_t i = 0; i < m_cacheLines; i++) {
+        if (m_cache[i].valid && m_cache[i].page == page) {
+            return &m_cache[i];
+        }
+    }
+    return nullptr;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline void EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::AttachReadCache(CacheLine* lines, uint8_t count) {
+    m_cache = lines;
+    m_cacheLines = (lines != nullptr) ? count : 0;
+    m_cacheNext = 0;
+    for (uint8_t i = 0; i < m_cacheLines; i++) {
+        m_cache[i].valid = false;
+    }
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline uint32_t EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::GetCacheHits() const {
+    return m_cacheHits;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline uint32_t EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::GetCacheMisses() const {
+    return m_cacheMisses;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline void EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::ResetCacheStats() {
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline uint8_t EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::PutAddress(uint8_t* buf, uint16_t memAddr) {
+    uint8_t n = 0;
+    if (ADDRESS_BYTES == 2) {
+        buf[n++] = static_cast<uint8_t>((memAddr >> 8) & 0xFF);
+    }
+    buf[n++] = static_cast<uint8_t>(memAddr & 0xFF);
+    return n;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::ReadRange(uint16_t startAddr, int16_t* out, uint16_t count) {
+    if ((startAddr % BYTES_PER_SAMPLE) != 0 || startAddr >= CAPACITY ||
+        count == 0 || count > CAPACITY / BYTES_PER_SAMPLE) {
+        return false;
+    }
+    
+    // Stream raw big-endian bytes straight into the output array
+    uint8_t* raw = reinterpret_cast<uint8_t*>(out);
+    uint32_t totalBytes = static_cast<uint32_t>(count) * BYTES_PER_SAMPLE;
+    uint32_t firstBytes = CAPACITY - startAddr;
+    if (firstBytes > totalBytes) {
+        firstBytes = totalBytes;
+    }
+    
+    if (!ReadBytes(startAddr, raw, firstBytes)) {
+        return false;
+    }
+    
+    // Ring wrapped past the end of the EEPROM - continue at address 0
+    if (totalBytes > firstBytes &&
+        !ReadBytes(0, raw + firstBytes, totalBytes - firstBytes)) {
+        return false;
+    }
+    
+    // Decode in place: each sample's two bytes are read before being overwritten
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t hi = raw[i * 2];
+        uint8_t lo = raw[i * 2 + 1];
+        out[i] = static_cast<int16_t>((static_cast<uint16_t>(hi) << 8) | lo);
+    }
+    return true;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline uint16_t EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::Packed12Address(uint16_t sampleIndex) {
+    uint16_t page = sampleIndex / PACKED12_SAMPLES_PER_PAGE;
+    uint8_t slot = static_cast<uint8_t>(sampleIndex % PACKED12_SAMPLES_PER_PAGE);
+    return static_cast<uint16_t>((page << PAGE_SHIFT) + (slot / 2) * 3 + (slot & 1));
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::WritePacked12(uint16_t sampleIndex,
+                                                                            const int16_t* samples, uint16_t count) {
+    if (count == 0 || static_cast<uint32_t>(sampleIndex) + count > PACKED12_CAPACITY) {
+        return false;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        if (samples[i] < -2048 || samples[i] > 2047) {
+            return false;  // Does not fit in 12 bits
+        }
+    }
+    
+    uint16_t done = 0;
+    while (done < count) {
+        // Samples that fit in the current page
+        uint16_t first = static_cast<uint16_t>(sampleIndex + done);
+        uint8_t slot = static_cast<uint8_t>(first % PACKED12_SAMPLES_PER_PAGE);
+        uint16_t n = static_cast<uint16_t>(PACKED12_SAMPLES_PER_PAGE - slot);
+        if (n > count - done) {
+            n = static_cast<uint16_t>(count - done);
+        }
+        uint16_t last = static_cast<uint16_t>(first + n - 1);
+        
+        uint16_t startAddr = Packed12Address(first);
+        uint8_t len = static_cast<uint8_t>(Packed12Address(last) + 2 - startAddr);
+        // Zeroed: an even sample merges the low nibble of buf[off + 1],
+        // which only holds device data for the last byte (pre-read below);
+        // inside the run the following odd sample overwrites it
+        uint8_t buf[PAGE_SIZE] = {};
+        
+        // Preserve the neighbour's nibble in shared bytes
+        if ((first & 1) != 0 && !ReadBytes(startAddr, &buf[0], 1)) {
+            return false;
+        }
+        if ((last & 1) == 0 && !ReadBytes(static_cast<uint16_t>(startAddr + len - 1), &buf[len - 1], 1)) {
+            return false;
+        }
+        
+        for (uint16_t i = 0; i < n; i++) {
+            uint16_t index = static_cast<uint16_t>(first + i);
+            uint8_t off = static_cast<uint8_t>(Packed12Address(index) - startAddr);
+            uint16_t v = static_cast<uint16_t>(samples[done + i]) & 0x0FFF;
+            
+            if ((index & 1) == 0) {
+                buf[off] = static_cast<uint8_t>(v >> 4);
+                buf[off + 1] = static_cast<uint8_t>(((v & 0x0F) << 4) | (buf[off + 1] & 0x0F));
+            } else {
+                buf[off] = static_cast<uint8_t>((buf[off] & 0xF0) | (v >> 8));
+                buf[off + 1] = static_cast<uint8_t>(v & 0xFF);
+            }
+        }
+        
+        if (!WritePage(startAddr, buf, len)) {
+            return false;
+        }
+        done = static_cast<uint16_t>(done + n);
+    }
+    return true;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::ReadPacked12(uint16_t sampleIndex, int16_t* out, uint16_t count) {
+    if (count == 0 || static_cast<uint32_t>(sampleIndex) + count > PACKED12_CAPACITY) {
+        return false;
+    }
+    
+    uint16_t startAddr = Packed12Address(sampleIndex);
+    uint16_t lastIndex = static_cast<uint16_t>(sampleIndex + count - 1);
+    uint16_t len = static_cast<uint16_t>(Packed12Address(lastIndex) + 2 - startAddr);
+    
+    // Packed bytes are read straight into out[] and unpacked in place,
+    // back to front. Only the first bytes can still be needed after a later
+    // sample's slot has overwritten them (a page gap near the start makes
+    // the packed data locally denser than 2 bytes/sample), so a copy of
+    // those is kept. Short runs across a gap may exceed out[] entirely and
+    // are read into the copy instead.
+    static constexpr uint8_t HEAD_BYTES = 16;
+    uint8_t head[HEAD_BYTES];
+    uint8_t* raw = reinterpret_cast<uint8_t*>(out);
+    
+    if (len > static_cast<uint32_t>(count) * BYTES_PER_SAMPLE) {
+        if (len > HEAD_BYTES || !ReadBytes(startAddr, head, len)) {
+            return false;
+        }
+        raw = head;
+    } else {
+        if (!ReadBytes(startAddr, raw, len)) {
+            return false;
+        }
+        for (uint16_t i = 0; i < HEAD_BYTES && i < len; i++) {
+            head[i] = raw[i];
+        }
+    }
+    
+    for (uint16_t i = count; i-- > 0;) {
+        uint16_t index = static_cast<uint16_t>(sampleIndex + i);
+        uint16_t off = static_cast<uint16_t>(Packed12Address(index) - startAddr);
+        uint8_t b0 = (off < HEAD_BYTES) ? head[off] : raw[off];
+        uint8_t b1 = (off + 1 < HEAD_BYTES) ? head[off + 1] : raw[off + 1];
+        
+        uint16_t v = ((index & 1) == 0)
+            ? static_cast<uint16_t>((b0 << 4) | (b1 >> 4))
+            : static_cast<uint16_t>(((b0 & 0x0F) << 8) | b1);
+        
+        // Sign-extend 12 -> 16 bits
+        out[i] = static_cast<int16_t>((v & 0x0800) ? (v | 0xF000) : v);
+    }
+    return true;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline void EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::SetAsyncWrites(bool enable) {
+    m_asyncWrites = enable;
+    if (!enable && m_writePending) {
+        WaitForWriteComplete();  // On timeout the next access waits again
+    }
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::Poll() {
+    if (!m_writePending) {
+        return true;
+    }
+    
+    if (m_i2c.Write(m_address, nullptr, 0) == I2CStatus::OK) {
+        m_writePending = false;  // Device acknowledged - write complete
+        return true;
+    }
+    return false;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::IsBusy() const {
+    return m_writePending;
+}
+
+template <uint32_t Capacity, uint16_t PageSize, uint8_t AddrBytes, uint8_t WriteCycleMs, typename Bus>
+inline bool EEPROM24xx<Capacity, PageSize, AddrBytes, WriteCycleMs, Bus>::WaitForWriteComplete() {
+    // ~100μs per attempt: budget twice the rated write cycle
+    const int maxAttempts = 20 * WRITE_CYCLE_MS_MAX;
+    
+    for (int attempt = 0; attempt < maxAttempts; attempt++) {
+        if (m_i2c.Write(m_address, nullptr, 0) == I2CStatus::OK) {
+            m_writePending = false;  // Device acknowledged - write complete
+            return true;
+        }
+        
+        // Wait ~100μs before next attempt
+        for (volatile int i = 0; i < 1000; i++) {}
+    }
+    return false;  // Still pending: the next access polls again
+}
+
+// Supported parts (Microchip 24xx, all 2-byte addressed, 5ms write cycle),
+// bound to a concrete bus type
+template <typename Bus> using EEPROM24LC64T  = EEPROM24xx<8192, 32, 2, 5, Bus>;
+template <typename Bus> using EEPROM24FC256T = EEPROM24xx<32768, 64, 2, 5, Bus>;
+template <typename Bus> using EEPROM24FC512T = EEPROM24xx<65536, 128, 2, 5, Bus>;
+
+// Same parts over the virtual II2CController interface
+using EEPROM24LC64  = EEPROM24LC64T<II2CController>;
+using EEPROM24FC256 = EEPROM24FC256T<II2CController>;
+using EEPROM24FC512 = EEPROM24FC512T<II2CController>;
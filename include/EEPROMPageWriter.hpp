@@ -0,0 +1,205 @@
+/**
+ * @file EEPROMPageWriter.hpp
+ * @brief RAM page staging for batched 24FC256 page writes
+ *
+ * LogData() costs one 4-byte transaction and one full write cycle (~5ms)
+ * per 2-byte sample. EEPROMPageWriter collects samples in a 64-byte RAM
+ * image of the current page and writes it with a single page write once
+ * the page is full (32 samples per write cycle, 2 address bytes per page).
+ *
+ * Behaviour:
+ * - Pages are always written inside their own 64-byte boundary (Section 6.2)
+ * - Flush() writes only the staged bytes that have not been written yet,
+ *   so a partial page can be made durable and then continued
+ * - The log region [startAddr, endAddr) is used as a circular buffer
+ * - Samples stay 2-byte aligned: an odd start or Seek() address is rounded
+ *   up to the next sample, so a sample never straddles the page image
+ *
+ * Staged samples are lost on reset until flushed - call Flush() before
+ * sleeping if every sample must survive a power loss.
+ */
+
+#pragma once
+#include "EEPROM24FC256.hpp"
+#include <cstdint>
+
+class EEPROMPageWriter {
+public:
+    /// Log region [startAddr, endAddr), page aligned (default: whole device);
+    /// an odd startAddr is rounded up to the next sample
+    EEPROMPageWriter(EEPROM24FC256& eeprom,
+                     uint16_t startAddr = 0,
+                     uint32_t endAddr = EEPROM24FC256::CAPACITY);
+
+    /// Stage one Q12.4 sample; writes the page when it becomes full
+    /// Returns false if a page write failed (sample stays staged for retry)
+    bool Append(int16_t encoded);
+
+    /// Stage one temperature (same as Append(temp.Raw()))
+    bool Append(Temperature temp);
+
+    /**
+     * @brief Stage count samples as one record: all of them or none
+     *
+     * Append() leaves the samples before a failed page write staged, so a
+     * record written word by word could be cut short and the next record
+     * would continue the stream mid-record. Here a failed page write
+     * unstages the whole record instead.
+     *
+     * @param count Samples in the record (count * 2 <= PAGE_SIZE)
+     * @return false if a page write failed (nothing of the record is
+     *         staged) or the record is larger than a page
+     */
+    bool AppendRecord(const int16_t* samples, uint8_t count);
+
+#ifndef TEMPLOGGER_NO_FLOAT
+    /// Stage one temperature from degrees C (host-side)
+    bool Append(float temp);
+#endif
+
+    /// Write all staged-but-unwritten bytes of the current page
+    bool Flush();
+
+    /// Move the write position (unflushed samples are dropped - Flush() first);
+    /// an odd memAddr is rounded up to the next sample
+    void Seek(uint16_t memAddr);
+
+    /// EEPROM address the next appended sample will occupy
+    uint16_t GetWriteAddress() const;
+
+    /// Number of samples staged in RAM that are not yet in EEPROM
+    uint8_t GetPendingSamples() const;
+
+private:
+    static constexpr uint8_t PAGE_SIZE = EEPROM24FC256::PAGE_SIZE;
+
+    EEPROM24FC256& m_eeprom;
+    uint16_t m_startAddr;
+    uint32_t m_endAddr;
+
+    uint8_t  m_page[PAGE_SIZE];  ///< RAM image of the current page
+    uint16_t m_pageBase;         ///< EEPROM address of m_page[0]
+    uint8_t  m_fill;             ///< Bytes staged in m_page
+    uint8_t  m_flushed;          ///< Bytes of m_page already written
+
+    /// Flush a full page and move on to the next one (wraps at m_endAddr)
+    bool FlushAndAdvance();
+};
+
+// Inline implementations
+
+inline EEPROMPageWriter::EEPROMPageWriter(EEPROM24FC256& eeprom,
+                                          uint16_t startAddr,
+                                          uint32_t endAddr)
+    : m_eeprom(eeprom),
+      m_startAddr(static_cast<uint16_t>(startAddr + (startAddr % EEPROM24FC256::BYTES_PER_SAMPLE))),
+      m_endAddr(endAddr),
+      m_page{}, m_pageBase(0), m_fill(0), m_flushed(0) {
+    Seek(startAddr);
+}
+
+inline void EEPROMPageWriter::Seek(uint16_t memAddr) {
+    // m_fill must stay even: Append() writes m_page[m_fill + 1]
+    uint32_t aligned = static_cast<uint32_t>(memAddr) + (memAddr % EEPROM24FC256::BYTES_PER_SAMPLE);
+    memAddr = static_cast<uint16_t>(aligned);
+    if (aligned >= m_endAddr || memAddr < m_startAddr) {
+        memAddr = m_startAddr;
+    }
+
+    m_pageBase = static_cast<uint16_t>(memAddr - (memAddr % PAGE_SIZE));
+    m_fill = static_cast<uint8_t>(memAddr - m_pageBase);
+    m_flushed = m_fill;  // Bytes before memAddr are left untouched
+}
+
+inline bool EEPROMPageWriter::Append(Temperature temp) {
+    return Append(temp.Raw());
+}
+
+#ifndef TEMPLOGGER_NO_FLOAT
+inline bool EEPROMPageWriter::Append(float temp) {
+    return Append(EEPROM24FC256::EncodeTemperature(temp));
+}
+#endif
+
+inline bool EEPROMPageWriter::Append(int16_t encoded) {
+    // Previous page write failed - retry it before staging more
+    if (m_fill == PAGE_SIZE && !FlushAndAdvance()) {
+        return false;
+    }
+
+    m_page[m_fill]     = static_cast<uint8_t>((encoded >> 8) & 0xFF);
+    m_page[m_fill + 1] = static_cast<uint8_t>(encoded & 0xFF);
+    m_fill += EEPROM24FC256::BYTES_PER_SAMPLE;
+
+    if (m_fill == PAGE_SIZE) {
+        return FlushAndAdvance();
+    }
+    return true;
+}
+
+inline bool EEPROMPageWriter::AppendRecord(const int16_t* samples, uint8_t count) {
+    if (count * EEPROM24FC256::BYTES_PER_SAMPLE > PAGE_SIZE) {
+        return false;
+    }
+
+    // Previous page write failed - retry it before staging more
+    if (m_fill == PAGE_SIZE && !FlushAndAdvance()) {
+        return false;
+    }
+
+    // A record no larger than a page crosses at most one page boundary,
+    // and only a write at that boundary can fail: none of the record has
+    // reached the device yet, so dropping it from the image undoes it
+    uint8_t recordStart = m_fill;
+    for (uint8_t i = 0; i < count; i++) {
+        m_page[m_fill]     = static_cast<uint8_t>((samples[i] >> 8) & 0xFF);
+        m_page[m_fill + 1] = static_cast<uint8_t>(samples[i] & 0xFF);
+        m_fill += EEPROM24FC256::BYTES_PER_SAMPLE;
+
+        if (m_fill == PAGE_SIZE && !FlushAndAdvance()) {
+            m_fill = recordStart;
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool EEPROMPageWriter::Flush() {
+    if (m_flushed == m_fill) {
+        return true;  // Nothing new to write
+    }
+
+    uint16_t addr = static_cast<uint16_t>(m_pageBase + m_flushed);
+    uint8_t len = static_cast<uint8_t>(m_fill - m_flushed);
+
+    if (!m_eeprom.WritePage(addr, &m_page[m_flushed], len)) {
+        return false;
+    }
+
+    m_flushed = m_fill;
+    return true;
+}
+
+inline bool EEPROMPageWriter::FlushAndAdvance() {
+    if (!Flush()) {
+        return false;
+    }
+
+    uint32_t next = static_cast<uint32_t>(m_pageBase) + PAGE_SIZE;
+    m_pageBase = (next >= m_endAddr) ? m_startAddr : static_cast<uint16_t>(next);
+    m_fill = 0;
+    m_flushed = 0;
+    return true;
+}
+
+inline uint16_t EEPROMPageWriter::GetWriteAddress() const {
+    if (m_fill == PAGE_SIZE) {
+        uint32_t next = static_cast<uint32_t>(m_pageBase) + PAGE_SIZE;
+        return (next >= m_endAddr) ? m_startAddr : static_cast<uint16_t>(next);
+    }
+    return static_cast<uint16_t>(m_pageBase + m_fill);
+}
+
+inline uint8_t EEPROMPageWriter::GetPendingSamples() const {
+    return static_cast<uint8_t>((m_fill - m_flushed) / EEPROM24FC256::BYTES_PER_SAMPLE);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file EEPROMVolume.hpp
+ * @brief Logical volume striped across several 24FC256 devices
+ *
+ * The 24FC256 has three address pins (A2..A0), so up to eight devices
+ * share one bus at 0x50-0x57. EEPROMVolume presents N devices as one
+ * linear address space of N x 32 KB.
+ *
+ * Striping: consecutive 64-byte pages go to consecutive devices
+ *   logical page P -> device (P % N), device page (P / N)
+ *
+ * With the devices in async write mode, a page write to device k returns
+ * as soon as the data is accepted and the next page goes to device k+1,
+ * which is idle. A device is only waited on when the volume comes back
+ * to it N pages later, so up to N write cycles overlap and sequential
+ * write throughput is no longer limited by one device's 5ms write cycle.
+ *
+ * Reads are split per page (each page lives on a different device), so
+ * a bulk read costs one transaction per page rather than one in total.
+ */
+
+#pragma once
+#include "EEPROM24FC256.hpp"
+#include <cstdint>
+
+class EEPROMVolume {
+public:
+    static constexpr uint8_t  MAX_DEVICES = 8;
+    static constexpr uint8_t  PAGE_SIZE = EEPROM24FC256::PAGE_SIZE;
+
+    /**
+     * @brief Build a volume from caller-owned devices
+     * @param devices Device drivers in stripe order (e.g. 0x50, 0x51, ...)
+     * @param count Number of devices (1..MAX_DEVICES, extra entries ignored)
+     */
+    EEPROMVolume(EEPROM24FC256* const* devices, uint8_t count);
+
+    /// Total size in bytes (count x 32 KB)
+    uint32_t GetCapacity() const;
+
+    /// Number of devices in the volume
+    uint8_t GetDeviceCount() const;
+
+    /// Put every device in async (overlapped) or blocking write mode
+    void SetAsyncWrites(bool enable);
+
+    /// Write up to one logical page (must not cross a 64-byte boundary)
+    bool WritePage(uint32_t addr, const uint8_t* data, uint8_t len);
+
+    /// Read any range, split at page boundaries across devices
+    bool ReadBytes(uint32_t addr, uint8_t* data, uint32_t len);
+
+    /// One ACK poll on every busy device; true when all are idle
+    bool Poll();
+
+private:
+    EEPROM24FC256* m_devices[MAX_DEVICES];
+    uint8_t m_count;
+
+    /// Map a logical address to its device and device address
+    EEPROM24FC256& Locate(uint32_t addr, uint16_t& devAddr) const;
+};
+
+// Inline implementations
+
+inline EEPROMVolume::EEPROMVolume(EEPROM24FC256* const* devices, uint8_t count)
+    : m_devices{}, m_count(count > MAX_DEVICES ? MAX_DEVICES : count) {
+    for (uint8_t i = 0; i < m_count; i++) {
+        m_devices[i] = devices[i];
+    }
+}
+
+inline uint32_t EEPROMVolume::GetCapacity() const {
+    return static_cast<uint32_t>(m_count) * EEPROM24FC256::CAPACITY;
+}
+
+inline uint8_t EEPROMVolume::GetDeviceCount() const {
+    return m_count;
+}
+
+inline void EEPROMVolume::SetAsyncWrites(bool enable) {
+    for (uint8_t i = 0; i < m_count; i++) {
+        m_devices[i]->SetAsyncWrites(enable);
+    }
+}
+
+inline EEPROM24FC256& EEPROMVolume::Locate(uint32_t addr, uint16_t& devAddr) const {
+    uint32_t page = addr / PAGE_SIZE;
+    devAddr = static_cast<uint16_t>((page / m_count) * PAGE_SIZE + (addr % PAGE_SIZE));
+    return *m_devices[page % m_count];
+}
+
+inline bool EEPROMVolume::WritePage(uint32_t addr, const uint8_t* data, uint8_t len) {
+    if (m_count == 0 || len == 0 || addr + len > GetCapacity() ||
+        (addr % PAGE_SIZE) + len > PAGE_SIZE) {
+        return false;
+    }
+
+    uint16_t devAddr = 0;
+    EEPROM24FC256& dev = Locate(addr, devAddr);
+    return dev.WritePage(devAddr, data, len);
+}
+
+inline bool EEPROMVolume::ReadBytes(uint32_t addr, uint8_t* data, uint32_t len) {
+    if (m_count == 0 || len == 0 || addr + len > GetCapacity()) {
+        return false;
+    }
+
+    while (len > 0) {
+        uint32_t chunk = PAGE_SIZE - (addr % PAGE_SIZE);
+        if (chunk > len) {
+            chunk = len;
+        }
+
+        uint16_t devAddr = 0;
+        EEPROM24FC256& dev = Locate(addr, devAddr);
+        if (!dev.ReadBytes(devAddr, data, static_cast<uint16_t>(chunk))) {
+            return false;
+        }
+
+        addr += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+    return true;
+}
+
+inline bool EEPROMVolume::Poll() {
+    bool idle = true;
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (!m_devices[i]->Poll()) {
+            idle = false;
+        }
+    }
+    return idle;
+}
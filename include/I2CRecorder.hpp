@@ -0,0 +1,456 @@
+/**
+ * @file I2CRecorder.hpp
+ * @brief I2C traffic capture, recording decorator and replayer
+ *
+ * I2CRecorder sits between the drivers and a controller and appends
+ * every transaction to an I2CCapture: operation, address, status,
+ * timestamp, the bytes written and the bytes read. I2CReplayer is a
+ * controller that serves a capture back to the drivers: each call must
+ * match the next recorded transaction (operation, address, written
+ * bytes, read length) and gets the recorded status and read bytes, so a
+ * driver can be re-run deterministically without any device model.
+ *
+ * Uses:
+ * - Diff the traffic of two runs (FirstDifference()) to see exactly
+ *   which transaction a driver change added, removed or altered
+ * - Count transactions and wire bytes per sample to catch regressions
+ * - Replay a capture against changed drivers: the first transaction they
+ *   issue differently is reported (GetDivergence())
+ *
+ * Record format (little endian), in a caller-supplied buffer:
+ *   [op | status << 4] [addr] [txLen:2] [rxLen:2] [timestamp:4]
+ *   [tx bytes] [rx bytes]
+ * Gathered writes (WriteV) are recorded as one Write of header + data,
+ * and each Transfer() entry as its own record, since that is what is on
+ * the wire. When a record does not fit, the capture ends there (it stays
+ * a gap-free prefix of the run, so it can still be replayed) and later
+ * records are only counted; the recorder keeps forwarding.
+ */
+
+#pragma once
+#include "II2CController.hpp"
+#include "ITimer.hpp"
+#include <cstdint>
+#include <cstddef>
+
+/// Transaction shape on the wire
+enum class I2COp : uint8_t {
+    Write,      ///< START - ADDR+W - TX - STOP
+    Read,       ///< START - ADDR+R - RX - STOP
+    WriteRead   ///< START - ADDR+W - TX - REPEATED START - ADDR+R - RX - STOP
+};
+
+/// One decoded record (pointers into the capture buffer)
+struct I2CRecord {
+    I2COp          op;
+    uint8_t        addr;
+    I2CStatus      status;
+    uint32_t       timestamp;
+    const uint8_t* tx;
+    uint16_t       txLen;
+    const uint8_t* rx;
+    uint16_t       rxLen;
+};
+
+class I2CCapture {
+public:
+    static constexpr size_t RECORD_HEADER = 10;
+    static constexpr size_t NO_DIFFERENCE = SIZE_MAX;
+
+    /// Capture into buffer; used > 0 wraps previously saved records
+    I2CCapture(uint8_t* buffer, size_t capacity, size_t used = 0);
+
+    /**
+     * @brief Append one transaction (tx given as two spans)
+     * @return false if it did not fit or an earlier record was dropped
+     */
+    bool Append(I2COp op, uint8_t addr, I2CStatus status, uint32_t timestamp,
+                const uint8_t* tx1, size_t tx1Len, const uint8_t* tx2, size_t tx2Len,
+                const uint8_t* rx, size_t rxLen);
+
+    /**
+     * @brief Decode the record at offset and advance offset past it
+     * @return false at the end of the capture
+     */
+    bool Next(size_t& offset, I2CRecord& record) const;
+
+    /// Forget all records
+    void Clear();
+
+    /// Encoded records (for saving to a file on the host)
+    const uint8_t* GetData() const;
+    size_t GetSize() const;
+
+    uint32_t GetRecordCount() const;
+
+    /// Address, payload and repeated-start address bytes of all records
+    uint32_t GetWireBytes() const;
+
+    /// Records not captured since the first one that did not fit
+    uint32_t GetDropped() const;
+
+    /**
+     * @brief Index of the first record that differs (timestamps ignored)
+     * @return NO_DIFFERENCE if both hold the same transactions
+     */
+    static size_t FirstDifference(const I2CCapture& a, const I2CCapture& b);
+
+    /// Same operation, address, status and bytes (timestamps ignored)
+    static bool SameTransaction(const I2CRecord& a, const I2CRecord& b);
+
+private:
+    uint8_t* m_buffer;
+    size_t   m_capacity;
+    size_t   m_size;
+    uint32_t m_records;
+    uint32_t m_wireBytes;
+    uint32_t m_dropped;
+
+    static uint32_t WireBytes(const I2CRecord& r);
+};
+
+/// II2CController decorator that records all traffic
+class I2CRecorder final : public II2CController {
+public:
+    /// Forward to bus and record into capture; timestamps from timer (0 without one)
+    I2CRecorder(II2CController& bus, I2CCapture& capture, const ITimer* timer = nullptr);
+
+    I2CStatus Write(uint8_t addr, const uint8_t* data, size_t len) override;
+    I2CStatus Read(uint8_t addr, uint8_t* buffer, size_t len) override;
+    I2CStatus WriteRead(uint8_t addr, const uint8_t* tx, size_t txLen,
+                        uint8_t* rx, size_t rxLen) override;
+    I2CStatus WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                     const uint8_t* data, size_t dataLen) override;
+    I2CStatus Transfer(I2CTransaction* list, size_t count) override;
+
+    /// Pause or resume recording (traffic is forwarded either way)
+    void SetEnabled(bool enable);
+
+private:
+    II2CController& m_bus;
+    I2CCapture& m_capture;
+    const ITimer* m_timer;
+    bool m_enabled;
+
+    void Record(I2COp op, uint8_t addr, I2CStatus status,
+                const uint8_t* tx1, size_t tx1Len, const uint8_t* tx2, size_t tx2Len,
+                const uint8_t* rx, size_t rxLen);
+};
+
+/// II2CController that answers from a capture
+class I2CReplayer final : public II2CController {
+public:
+    static constexpr size_t NO_DIVERGENCE = SIZE_MAX;
+
+    explicit I2CReplayer(const I2CCapture& capture);
+
+    I2CStatus Write(uint8_t addr, const uint8_t* data, size_t len) override;
+    I2CStatus Read(uint8_t addr, uint8_t* buffer, size_t len) override;
+    I2CStatus WriteRead(uint8_t addr, const uint8_t* tx, size_t txLen,
+                        uint8_t* rx, size_t rxLen) override;
+    I2CStatus WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                     const uint8_t* data, size_t dataLen) override;
+    I2CStatus Transfer(I2CTransaction* list, size_t count) override;
+
+    /// Every record replayed and no mismatch
+    bool IsComplete() const;
+
+    /**
+     * @brief Index of the first call that did not match its record
+     *
+     * From then on every call returns Error: the drivers have left the
+     * recorded path and later records no longer line up.
+     */
+    size_t GetDivergence() const;
+
+    /// Records replayed so far
+    uint32_t GetPosition() const;
+
+private:
+    const I2CCapture& m_capture;
+    size_t   m_offset;
+    uint32_t m_position;
+    size_t   m_divergence;
+
+    /// Match the next record; on success copy its rx bytes and return its status
+    I2CStatus Replay(I2COp op, uint8_t addr,
+                     const uint8_t* tx1, size_t tx1Len, const uint8_t* tx2, size_t tx2Len,
+                     uint8_t* rx, size_t rxLen);
+};
+
+// Inline implementations
+
+inline I2CCapture::I2CCapture(uint8_t* buffer, size_t capacity, size_t used)
+    : m_buffer(buffer), m_capacity(capacity), m_size(0), m_records(0), m_wireBytes(0), m_dropped(0) {
+    // Rebuild the counters of a saved capture; stop at a truncated record
+    I2CRecord r;
+    size_t offset = 0;
+    m_size = (used < capacity) ? used : capacity;  // Never parse past the buffer
+    while (Next(offset, r)) {
+        m_records++;
+        m_wireBytes += WireBytes(r);
+    }
+    m_size = offset;
+}
+
+inline uint32_t I2CCapture::WireBytes(const I2CRecord& r) {
+    uint32_t bytes = static_cast<uint32_t>(1 + r.txLen + r.rxLen);
+    return (r.op == I2COp::WriteRead) ? bytes + 1 : bytes;
+}
+
+inline bool I2CCapture::Append(I2COp op, uint8_t addr, I2CStatus status, uint32_t timestamp,
+                               const uint8_t* tx1, size_t tx1Len, const uint8_t* tx2, size_t tx2Len,
+                               const uint8_t* rx, size_t rxLen) {
+    size_t txLen = tx1Len + tx2Len;
+    size_t need = RECORD_HEADER + txLen + rxLen;
+    if (m_dropped > 0 || txLen > UINT16_MAX || rxLen > UINT16_MAX || need > m_capacity - m_size) {
+        m_dropped++;
+        return false;
+    }
+
+    uint8_t* p = m_buffer + m_size;
+    p[0] = static_cast<uint8_t>(static_cast<uint8_t>(op) | (static_cast<uint8_t>(status) << 4));
+    p[1] = addr;
+    p[2] = static_cast<uint8_t>(txLen & 0xFF);
+    p[3] = static_cast<uint8_t>(txLen >> 8);
+    p[4] = static_cast<uint8_t>(rxLen & 0xFF);
+    p[5] = static_cast<uint8_t>(rxLen >> 8);
+    for (uint8_t i = 0; i < 4; i++) {
+        p[6 + i] = static_cast<uint8_t>(timestamp >> (8 * i));
+    }
+    p += RECORD_HEADER;
+    for (size_t i = 0; i < tx1Len; i++) {
+        *p++ = tx1[i];
+    }
+    for (size_t i = 0; i < tx2Len; i++) {
+        *p++ = tx2[i];
+    }
+    for (size_t i = 0; i < rxLen; i++) {
+        *p++ = rx[i];
+    }
+
+    m_size += need;
+    m_records++;
+    m_wireBytes += static_cast<uint32_t>(1 + txLen + rxLen + (op == I2COp::WriteRead ? 1 : 0));
+    return true;
+}
+
+inline bool I2CCapture::Next(size_t& offset, I2CRecord& record) const {
+    if (offset + RECORD_HEADER > m_size) {
+        return false;
+    }
+    const uint8_t* p = m_buffer + offset;
+    uint16_t txLen = static_cast<uint16_t>(p[2] | (p[3] << 8));
+    uint16_t rxLen = static_cast<uint16_t>(p[4] | (p[5] << 8));
+    if (offset + RECORD_HEADER + txLen + rxLen > m_size) {
+        return false;
+    }
+
+    record.op = static_cast<I2COp>(p[0] & 0x0F);
+    record.status = static_cast<I2CStatus>(p[0] >> 4);
+    record.addr = p[1];
+    record.timestamp = static_cast<uint32_t>(p[6]) | (static_cast<uint32_t>(p[7]) << 8) |
+                       (static_cast<uint32_t>(p[8]) << 16) | (static_cast<uint32_t>(p[9]) << 24);
+    record.tx = p + RECORD_HEADER;
+    record.txLen = txLen;
+    record.rx = record.tx + txLen;
+    record.rxLen = rxLen;
+    offset += RECORD_HEADER + txLen + rxLen;
+    return true;
+}
+
+inline void I2CCapture::Clear() {
+    m_size = 0;
+    m_records = 0;
+    m_wireBytes = 0;
+    m_dropped = 0;
+}
+
+inline const uint8_t* I2CCapture::GetData() const {
+    return m_buffer;
+}
+
+inline size_t I2CCapture::GetSize() const {
+    return m_size;
+}
+
+inline uint32_t I2CCapture::GetRecordCount() const {
+    return m_records;
+}
+
+inline uint32_t I2CCapture::GetWireBytes() const {
+    return m_wireBytes;
+}
+
+inline uint32_t I2CCapture::GetDropped() const {
+    return m_dropped;
+}
+
+inline bool I2CCapture::SameTransaction(const I2CRecord& a, const I2CRecord& b) {
+    if (a.op != b.op || a.addr != b.addr || a.status != b.status ||
+        a.txLen != b.txLen || a.rxLen != b.rxLen) {
+        return false;
+    }
+    for (uint16_t i = 0; i < a.txLen; i++) {
+        if (a.tx[i] != b.tx[i]) {
+            return false;
+        }
+    }
+    for (uint16_t i = 0; i < a.rxLen; i++) {
+        if (a.rx[i] != b.rx[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline size_t I2CCapture::FirstDifference(const I2CCapture& a, const I2CCapture& b) {
+    size_t offsetA = 0;
+    size_t offsetB = 0;
+    I2CRecord ra;
+    I2CRecord rb;
+    for (size_t index = 0;; index++) {
+        bool moreA = a.Next(offsetA, ra);
+        bool moreB = b.Next(offsetB, rb);
+        if (!moreA && !moreB) {
+            return NO_DIFFERENCE;
+        }
+        if (moreA != moreB || !SameTransaction(ra, rb)) {
+            return index;
+        }
+    }
+}
+
+inline I2CRecorder::I2CRecorder(II2CController& bus, I2CCapture& capture, const ITimer* timer)
+    : m_bus(bus), m_capture(capture), m_timer(timer), m_enabled(true) {
+}
+
+inline void I2CRecorder::Record(I2COp op, uint8_t addr, I2CStatus status,
+                                const uint8_t* tx1, size_t tx1Len, const uint8_t* tx2, size_t tx2Len,
+                                const uint8_t* rx, size_t rxLen) {
+    if (!m_enabled) {
+        return;
+    }
+    uint32_t timestamp = (m_timer != nullptr) ? m_timer->GetElapsedSeconds() : 0;
+    m_capture.Append(op, addr, status, timestamp, tx1, tx1Len, tx2, tx2Len, rx, rxLen);
+}
+
+inline I2CStatus I2CRecorder::Write(uint8_t addr, const uint8_t* data, size_t len) {
+    I2CStatus status = m_bus.Write(addr, data, len);
+    Record(I2COp::Write, addr, status, data, len, nullptr, 0, nullptr, 0);
+    return status;
+}
+
+inline I2CStatus I2CRecorder::Read(uint8_t addr, uint8_t* buffer, size_t len) {
+    I2CStatus status = m_bus.Read(addr, buffer, len);
+    Record(I2COp::Read, addr, status, nullptr, 0, nullptr, 0, buffer, len);
+    return status;
+}
+
+inline I2CStatus I2CRecorder::WriteRead(uint8_t addr, const uint8_t* tx, size_t txLen,
+                                        uint8_t* rx, size_t rxLen) {
+    I2CStatus status = m_bus.WriteRead(addr, tx, txLen, rx, rxLen);
+    Record(I2COp::WriteRead, addr, status, tx, txLen, nullptr, 0, rx, rxLen);
+    return status;
+}
+
+inline I2CStatus I2CRecorder::WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                                     const uint8_t* data, size_t dataLen) {
+    I2CStatus status = m_bus.WriteV(addr, header, headerLen, data, dataLen);
+    Record(I2COp::Write, addr, status, header, headerLen, data, dataLen, nullptr, 0);
+    return status;
+}
+
+inline I2CStatus I2CRecorder::Transfer(I2CTransaction* list, size_t count) {
+    // One batch on the bus, one record per entry
+    I2CStatus result = m_bus.Transfer(list, count);
+    for (size_t i = 0; i < count; i++) {
+        const I2CTransaction& t = list[i];
+        I2COp op = (t.rxLen == 0) ? I2COp::Write
+                 : (t.headerLen + t.dataLen == 0) ? I2COp::Read : I2COp::WriteRead;
+        Record(op, t.addr, t.status, t.header, t.headerLen, t.data, t.dataLen, t.rx, t.rxLen);
+    }
+    return result;
+}
+
+inline void I2CRecorder::SetEnabled(bool enable) {
+    m_enabled = enable;
+}
+
+inline I2CReplayer::I2CReplayer(const I2CCapture& capture)
+    : m_capture(capture), m_offset(0), m_position(0), m_divergence(NO_DIVERGENCE) {
+}
+
+inline I2CStatus I2CReplayer::Replay(I2COp op, uint8_t addr,
+                                     const uint8_t* tx1, size_t tx1Len, const uint8_t* tx2, size_t tx2Len,
+                                     uint8_t* rx, size_t rxLen) {
+    if (m_divergence != NO_DIVERGENCE) {
+        return I2CStatus::Error;
+    }
+
+    I2CRecord r;
+    size_t offset = m_offset;
+    bool match = m_capture.Next(offset, r) && r.op == op && r.addr == addr &&
+                 r.txLen == tx1Len + tx2Len && r.rxLen == rxLen;
+    for (size_t i = 0; match && i < tx1Len; i++) {
+        match = (r.tx[i] == tx1[i]);
+    }
+    for (size_t i = 0; match && i < tx2Len; i++) {
+        match = (r.tx[tx1Len + i] == tx2[i]);
+    }
+    if (!match) {
+        m_divergence = m_position;
+        return I2CStatus::Error;
+    }
+
+    for (size_t i = 0; i < rxLen; i++) {
+        rx[i] = r.rx[i];
+    }
+    m_offset = offset;
+    m_position++;
+    return r.status;
+}
+
+inline I2CStatus I2CReplayer::Write(uint8_t addr, const uint8_t* data, size_t len) {
+    return Replay(I2COp::Write, addr, data, len, nullptr, 0, nullptr, 0);
+}
+
+inline I2CStatus I2CReplayer::Read(uint8_t addr, uint8_t* buffer, size_t len) {
+    return Replay(I2COp::Read, addr, nullptr, 0, nullptr, 0, buffer, len);
+}
+
+inline I2CStatus I2CReplayer::WriteRead(uint8_t addr, const uint8_t* tx, size_t txLen,
+                                        uint8_t* rx, size_t rxLen) {
+    return Replay(I2COp::WriteRead, addr, tx, txLen, nullptr, 0, rx, rxLen);
+}
+
+inline I2CStatus I2CReplayer::WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                                     const uint8_t* data, size_t dataLen) {
+    return Replay(I2COp::Write, addr, header, headerLen, data, dataLen, nullptr, 0);
+}
+
+inline I2CStatus I2CReplayer::Transfer(I2CTransaction* list, size_t count) {
+    I2CStatus result = I2CStatus::OK;
+    for (size_t i = 0; i < count; i++) {
+        I2CTransaction& t = list[i];
+        I2COp op = (t.rxLen == 0) ? I2COp::Write
+                 : (t.headerLen + t.dataLen == 0) ? I2COp::Read : I2COp::WriteRead;
+        t.status = Replay(op, t.addr, t.header, t.headerLen, t.data, t.dataLen, t.rx, t.rxLen);
+        if (result == I2CStatus::OK) {
+            result = t.status;
+        }
+    }
+    return result;
+}
+
+inline bool I2CReplayer::IsComplete() const {
+    return m_divergence == NO_DIVERGENCE && m_position == m_capture.GetRecordCount();
+}
+
+inline size_t I2CReplayer::GetDivergence() const {
+    return m_divergence;
+}
+
+inline uint32_t I2CReplayer::GetPosition() const {
+    return m_position;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file IAsyncI2CController.hpp
+ * @brief Asynchronous (interrupt/DMA driven) I2C interface
+ *
+ * II2CController calls block until the transaction is off the wire; at
+ * 100 kHz a 66-byte page write keeps the CPU in the driver for ~6 ms.
+ * IAsyncI2CController takes the same I2CTransaction description, queues
+ * it and returns at once. The controller runs the queue from its
+ * interrupt (or DMA completion) handler and calls the submitter back
+ * when each transaction has finished, so the CPU can compute or sleep
+ * while bytes are on the wire, and a driver can queue its next transfer
+ * before the previous one is done.
+ *
+ * Callbacks run in interrupt context: keep them short (record the
+ * status, mark a buffer free, maybe submit the next transfer) and leave
+ * retries and heavier work to the main loop.
+ */
+
+#pragma once
+#include "II2CController.hpp"
+#include <cstdint>
+#include <cstddef>
+
+/// Completion callback; t.status holds the result. Runs in interrupt context.
+using I2CCallback = void (*)(void* context, I2CTransaction& t);
+
+class IAsyncI2CController {
+public:
+    virtual ~IAsyncI2CController() = default;
+
+    /**
+     * @brief Queue a transaction for the bus
+     *
+     * Transactions run in submission order. The transaction and every
+     * buffer it points to must stay valid until done() has been called.
+     * May be called from a completion callback.
+     *
+     * @return false if the queue is full (nothing was queued)
+     */
+    virtual bool Submit(I2CTransaction& t, I2CCallback done, void* context) = 0;
+
+    /// True while any submitted transaction has not completed
+    virtual bool IsBusy() const = 0;
+};
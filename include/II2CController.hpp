@@ -6,6 +6,14 @@
  * - Mock implementations for testing
  * - Easy swapping between bit-bang and hardware I2C
  * - Device drivers that don't depend on I2C implementation
+ * 
+ * Beyond the three primitives:
+ * - WriteV() sends a header span and a data span as one write, so a page
+ *   write does not have to copy its payload behind the address bytes
+ * - Transfer() runs a list of I2CTransaction in one call, so a sweep of
+ *   several devices costs one virtual call instead of one per device
+ * Both have defaults built on Write/Read/WriteRead; controllers that can
+ * feed the peripheral from two buffers (or DMA a list) override them.
  */
 
 #pragma once
@@ -20,6 +28,24 @@ enum class I2CStatus {
     Timeout   ///< Operation timed out
 };
 
+/**
+ * @brief One entry of a Transfer() batch
+ * 
+ * Write phase: header[0..headerLen-1] then data[0..dataLen-1] (either may
+ * be empty). Read phase, if rxLen > 0: after a repeated START (or a plain
+ * START when the write phase is empty). The controller fills in status.
+ */
+struct I2CTransaction {
+    uint8_t        addr;       ///< 7-bit device address
+    const uint8_t* header;     ///< e.g. register pointer or memory address
+    size_t         headerLen;
+    const uint8_t* data;       ///< Payload written after the header
+    size_t         dataLen;
+    uint8_t*       rx;         ///< Read buffer (nullptr if rxLen == 0)
+    size_t         rxLen;
+    I2CStatus      status;     ///< Result, set by Transfer()
+};
+
 /// Abstract I2C controller interface
 class II2CController {
 public:
@@ -44,4 +70,62 @@ public:
         }
         return Read(addr, rx, rxLen);
     }
+    
+    /// Largest write the default WriteV() can stage (24xx address + 128-byte page)
+    static constexpr size_t WRITEV_STAGING = 2 + 128;
+    
+    /// Gathered write: header then data in one transaction
+    /// Transaction: START - ADDR+W - HEADER[0..headerLen-1] - DATA[0..dataLen-1] - STOP
+    virtual I2CStatus WriteV(uint8_t addr,
+                             const uint8_t* header, size_t headerLen,
+                             const uint8_t* data, size_t dataLen) {
+        // Default: one span needs no copy; two are staged into one buffer
+        if (dataLen == 0) {
+            return Write(addr, header, headerLen);
+        }
+        if (headerLen == 0) {
+            return Write(addr, data, dataLen);
+        }
+        if (headerLen + dataLen > WRITEV_STAGING) {
+            return I2CStatus::Error;
+        }
+        uint8_t staged[WRITEV_STAGING];
+        for (size_t i = 0; i < headerLen; i++) {
+            staged[i] = header[i];
+        }
+        for (size_t i = 0; i < dataLen; i++) {
+            staged[headerLen + i] = data[i];
+        }
+        return Write(addr, staged, headerLen + dataLen);
+    }
+    
+    /**
+     * @brief Run a batch of transactions in order
+     * 
+     * Every entry is attempted, even after an earlier one fails (entries
+     * usually address independent devices), and gets its own status.
+     * A read phase after a non-empty data span is not supported by the
+     * default and reports Error.
+     * 
+     * @return OK if every entry succeeded, else the first failing status
+     */
+    virtual I2CStatus Transfer(I2CTransaction* list, size_t count) {
+        I2CStatus result = I2CStatus::OK;
+        for (size_t i = 0; i < count; i++) {
+            I2CTransaction& t = list[i];
+            if (t.rxLen == 0) {
+                t.status = WriteV(t.addr, t.header, t.headerLen, t.data, t.dataLen);
+            } else if (t.dataLen != 0) {
+                t.status = I2CStatus::Error;
+            } else if (t.headerLen == 0) {
+                t.status = Read(t.addr, t.rx, t.rxLen);
+            } else {
+                t.status = WriteRead(t.addr, t.header, t.headerLen, t.rx, t.rxLen);
+            }
+            if (result == I2CStatus::OK) {
+                result = t.status;
+            }
+        }
+        return result;
+    }
 };
@@ -3,7 +3,7 @@
  * @brief Abstract timer interface for 10-minute logging intervals
  * 
  * Allows swapping between:
- * - STM32Timer: Real hardware using SysTick
+ * - SysTickTimer: Real hardware using the SysTick interrupt
  * - MockTimer: Testing without hardware (manual tick control)
  */
 
@@ -17,7 +17,7 @@ public:
     /**
      * @brief Initialize the timer
      * 
-     * For STM32Timer: Configure SysTick for 1 Hz (1 second per tick)
+     * For SysTickTimer: Configure SysTick for 100 Hz (counted into seconds)
      * For MockTimer: No-op
      */
     virtual void Init() = 0;
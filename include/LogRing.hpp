@@ -0,0 +1,582 @@
+/**
+ * @file LogRing.hpp
+ * @brief Power-fail safe circular sample log with O(log n) boot recovery
+ *
+ * The write position of a plain circular buffer lives only in RAM, so after
+ * a reset the logger either restarts at address 0 (overwriting the newest
+ * data) or has to scan the whole EEPROM. LogRing stamps every page with a
+ * sequence number instead. Pages are written in order, so the pages from
+ * the start of the ring up to the write head carry consecutive sequence
+ * numbers and everything after the head does not. Recover() finds that
+ * boundary with a binary search over page headers: 11 small header reads
+ * for the 512 pages of a 24FC256, plus one read of the head page.
+ *
+ * Every page header also carries a time index: the timestamp of its
+ * first sample, the sample interval and the min/max of its samples.
+ * Pages are in time order, so Query() binary-searches headers for the
+ * first page of a time range and then reads only the pages inside it.
+ *
+ * Page layout (64 bytes, all fields big-endian):
+ *   [0..1]   sequence number (wraps at 65536)
+ *   [2]      sample count in this page (0..25)
+ *   [3]      check byte: seq_hi ^ seq_lo ^ count ^ 0xA5 (rejects erased
+ *            0xFF pages and torn headers)
+ *   [4..7]   base time: ITimer::GetElapsedSeconds() of the first sample
+ *   [8..9]   interval in seconds between samples
+ *   [10..11] min sample, Q12.4
+ *   [12..13] max sample, Q12.4
+ *   [14..63] 25 samples, Q12.4
+ *
+ * Sample i of a page was taken at base + i * interval. A sample that
+ * breaks the page's cadence (late, early or after a reset) closes the
+ * page and starts a new one, so every stored time is exact.
+ *
+ * Timestamps must not go backwards: Query() binary-searches page base
+ * times, which only works while they are in order across the whole ring.
+ * Append() rejects a sample older than the newest one logged (equal
+ * times are accepted), and Recover() restores that limit from the head
+ * page, so the caller's clock has to continue from GetLastTime() after
+ * a reset.
+ *
+ * Samples are staged in a RAM image of the head page. A full page is
+ * written with one page write; Flush() writes the partial head page
+ * (header + samples so far) so it survives a reset.
+ */
+
+#pragma once
+#include "EEPROM24FC256.hpp"
+#include <cstdint>
+
+class LogRing {
+public:
+    static constexpr uint8_t  PAGE_SIZE        = EEPROM24FC256::PAGE_SIZE;
+    static constexpr uint8_t  HEADER_SIZE      = 14;
+    static constexpr uint8_t  SAMPLES_PER_PAGE = (PAGE_SIZE - HEADER_SIZE) / EEPROM24FC256::BYTES_PER_SAMPLE;
+    static constexpr uint16_t DEVICE_PAGES     = EEPROM24FC256::CAPACITY / PAGE_SIZE;
+
+    /// Time index carried in every page header
+    struct PageInfo {
+        uint16_t seq;
+        uint8_t  count;
+        uint32_t baseTime;  ///< Timestamp of the first sample (seconds)
+        uint16_t interval;  ///< Seconds between samples
+        int16_t  minValue;  ///< Smallest sample in the page (Q12.4)
+        int16_t  maxValue;  ///< Largest sample in the page (Q12.4)
+    };
+
+    /// Ring occupies pages [firstPage, firstPage + pageCount)
+    LogRing(EEPROM24FC256& eeprom,
+            uint16_t firstPage = 0,
+            uint16_t pageCount = DEVICE_PAGES);
+
+    /**
+     * @brief Locate the write head after a reset
+     *
+     * Binary search for the last page whose sequence number continues
+     * the run started by the first page, then reload that page into RAM.
+     * A ring with no valid first page is treated as empty.
+     *
+     * @return false on I2C error
+     */
+    bool Recover();
+
+    /// Stage one Q12.4 sample taken at timestamp (seconds); writes the page
+    /// when it becomes full or the sample breaks the page's cadence
+    /// Returns false if timestamp is older than GetLastTime() or a page
+    /// write failed (sample is dropped)
+    bool Append(int16_t encoded, uint32_t timestamp);
+
+    /// Stage one sample on the current page's cadence (untimed logging;
+    /// the first sample of a page reuses GetLastTime())
+    bool Append(int16_t encoded);
+
+    /// Stage one temperature (same as Append(temp.Raw()))
+    bool Append(Temperature temp);
+
+#ifndef TEMPLOGGER_NO_FLOAT
+    /// Stage one temperature from degrees C (host-side)
+    bool Append(float temp);
+#endif
+
+    /// Write the staged head page (header + samples) to EEPROM
+    bool Flush();
+
+    /// Head page, relative to firstPage
+    uint16_t GetHeadPage() const;
+
+    /// Sequence number of the head page
+    uint16_t GetSequence() const;
+
+    /// Samples in the head page
+    uint8_t GetHeadCount() const;
+
+    /// Timestamp of the newest sample (0 if none), restored by Recover()
+    uint32_t GetLastTime() const;
+
+    /// Pages holding data, including the head page
+    uint16_t GetUsedPages() const;
+
+    /**
+     * @brief Read the samples of one page in log order
+     * @param age 0 = oldest page, GetUsedPages() - 1 = head page
+     * @param out Room for SAMPLES_PER_PAGE samples
+     * @param count Number of samples returned
+     */
+    bool ReadPage(uint16_t age, int16_t* out, uint8_t& count);
+
+    /// Read only the header of one page (age as for ReadPage)
+    bool ReadPageInfo(uint16_t age, PageInfo& info);
+
+    /**
+     * @brief Read the samples taken in [t1, t2]
+     *
+     * Binary search over page headers for the first page that can hold
+     * t1, then one read per page until a page starts after t2. Bus time
+     * grows with the size of the answer, not with the size of the log.
+     *
+     * @param out Room for maxCount samples
+     * @param times Optional room for maxCount timestamps
+     * @return Number of samples stored (stops at maxCount)
+     */
+    uint16_t Query(uint32_t t1, uint32_t t2, int16_t* out, uint16_t maxCount,
+                   uint32_t* times = nullptr);
+
+    /**
+     * @brief Min/max of the samples taken in [t1, t2]
+     *
+     * Pages entirely inside the range are answered from their header
+     * summary; only the pages at the two edges are read in full.
+     *
+     * @return false if no sample falls in the range or on I2C error
+     */
+    bool QueryMinMax(uint32_t t1, uint32_t t2, int16_t& minValue, int16_t& maxValue);
+
+private:
+    EEPROM24FC256& m_eeprom;
+    uint16_t m_firstPage;
+    uint16_t m_pageCount;
+
+    uint8_t  m_page[PAGE_SIZE];  ///< RAM image of the head page
+    uint16_t m_head;             ///< Head page, relative to m_firstPage
+    uint16_t m_seq;              ///< Sequence number of the head page
+    bool     m_wrapped;          ///< Pages after the head hold older data
+    bool     m_dirty;            ///< Head page image not yet written
+    uint32_t m_lastTime;         ///< Timestamp of the newest sample
+
+    static uint8_t HeaderCheck(uint16_t seq, uint8_t count);
+    static void ParseInfo(const uint8_t* hdr, PageInfo& info);
+    static void Put16(uint8_t* p, uint16_t v);
+    static uint16_t Get16(const uint8_t* p);
+    uint16_t PageAddress(uint16_t page) const;
+    uint16_t PhysicalPage(uint16_t age) const;
+    bool LoadPage(uint16_t age, const uint8_t*& data, uint8_t* buf);
+    uint16_t FindFirstPage(uint32_t t1);
+    bool ReadHeader(uint16_t page, uint16_t& seq, uint8_t& count, bool& valid);
+    void StartPage(uint16_t page, uint16_t seq);
+    void AdvancePage();
+};
+
+// Inline implementations
+
+inline LogRing::LogRing(EEPROM24FC256& eeprom, uint16_t firstPage, uint16_t pageCount)
+    : m_eeprom(eeprom), m_firstPage(firstPage), m_pageCount(pageCount),
+      m_page{}, m_head(0), m_seq(0), m_wrapped(false), m_dirty(false), m_lastTime(0) {
+    StartPage(0, 0);
+}
+
+inline uint8_t LogRing::HeaderCheck(uint16_t seq, uint8_t count) {
+    return static_cast<uint8_t>((seq >> 8) ^ (seq & 0xFF) ^ count ^ 0xA5);
+}
+
+inline void LogRing::Put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v >> 8);
+    p[1] = static_cast<uint8_t>(v & 0xFF);
+}
+
+inline uint16_t LogRing::Get16(const uint8_t* p) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) | p[1]);
+}
+
+inline void LogRing::ParseInfo(const uint8_t* hdr, PageInfo& info) {
+    info.seq = Get16(&hdr[0]);
+    info.count = hdr[2];
+    info.baseTime = (static_cast<uint32_t>(Get16(&hdr[4])) << 16) | Get16(&hdr[6]);
+    info.interval = Get16(&hdr[8]);
+    info.minValue = static_cast<int16_t>(Get16(&hdr[10]));
+    info.maxValue = static_cast<int16_t>(Get16(&hdr[12]));
+}
+
+inline uint16_t LogRing::PageAddress(uint16_t page) const {
+    return static_cast<uint16_t>((m_firstPage + page) * PAGE_SIZE);
+}
+
+inline bool LogRing::ReadHeader(uint16_t page, uint16_t& seq, uint8_t& count, bool& valid) {
+    // Recovery only needs sequence, count and check byte
+    uint8_t hdr[4];
+    if (!m_eeprom.ReadBytes(PageAddress(page), hdr, sizeof(hdr))) {
+        return false;
+    }
+
+    seq = Get16(&hdr[0]);
+    count = hdr[2];
+    valid = (hdr[3] == HeaderCheck(seq, count)) && (count <= SAMPLES_PER_PAGE);
+    return true;
+}
+
+inline void LogRing::StartPage(uint16_t page, uint16_t seq) {
+    for (uint8_t i = 0; i < PAGE_SIZE; i++) {
+        m_page[i] = 0xFF;
+    }
+    m_head = page;
+    m_seq = seq;
+    Put16(&m_page[0], seq);
+    m_page[2] = 0;
+    m_page[3] = HeaderCheck(seq, 0);
+    for (uint8_t i = 4; i < HEADER_SIZE; i++) {
+        m_page[i] = 0;  // Time index is filled in by the first sample
+    }
+    m_dirty = false;
+}
+
+inline bool LogRing::Recover() {
+    uint16_t seq0 = 0;
+    uint8_t count = 0;
+    bool valid = false;
+
+    if (!ReadHeader(0, seq0, count, valid)) {
+        return false;
+    }
+    if (!valid) {
+        m_wrapped = false;
+        m_lastTime = 0;
+        StartPage(0, 0);  // Empty ring
+        return true;
+    }
+
+    // Last page p with seq(p) == seq(0) + p; holds for 0 and fails past the head
+    uint16_t lo = 0;
+    uint16_t hi = static_cast<uint16_t>(m_pageCount - 1);
+    while (lo < hi) {
+        uint16_t mid = static_cast<uint16_t>((lo + hi + 1) / 2);
+        uint16_t seq = 0;
+        if (!ReadHeader(mid, seq, count, valid)) {
+            return false;
+        }
+        if (valid && static_cast<uint16_t>(seq - seq0) == mid) {
+            lo = mid;
+        } else {
+            hi = static_cast<uint16_t>(mid - 1);
+        }
+    }
+
+    // Older data follows the head if the next page holds a valid header
+    m_wrapped = false;
+    if (lo + 1 < m_pageCount) {
+        uint16_t seq = 0;
+        if (!ReadHeader(static_cast<uint16_t>(lo + 1), seq, count, valid)) {
+            return false;
+        }
+        m_wrapped = valid;
+    }
+
+    // Reload the head page so new samples continue where the log stopped
+    if (!m_eeprom.ReadBytes(PageAddress(lo), m_page, PAGE_SIZE)) {
+        return false;
+    }
+    m_head = lo;
+    m_seq = static_cast<uint16_t>(seq0 + lo);
+    m_dirty = false;
+
+    // New samples must not be older than the newest one on the device
+    PageInfo info;
+    ParseInfo(m_page, info);
+    m_lastTime = (info.count > 0)
+        ? info.baseTime + static_cast<uint32_t>(info.count - 1) * info.interval
+        : info.baseTime;
+
+    if (m_page[2] >= SAMPLES_PER_PAGE) {
+        AdvancePage();  // Head page is full - next sample opens a new one
+    }
+    return true;
+}
+
+inline void LogRing::AdvancePage() {
+    uint16_t next = static_cast<uint16_t>(m_head + 1);
+    if (next >= m_pageCount) {
+        next = 0;
+        m_wrapped = true;
+    }
+    StartPage(next, static_cast<uint16_t>(m_seq + 1));
+}
+
+inline bool LogRing::Append(Temperature temp) {
+    return Append(temp.Raw());
+}
+
+#ifndef TEMPLOGGER_NO_FLOAT
+inline bool LogRing::Append(float temp) {
+    return Append(EEPROM24FC256::EncodeTemperature(temp));
+}
+#endif
+
+inline bool LogRing::Append(int16_t encoded) {
+    PageInfo info;
+    ParseInfo(m_page, info);
+    uint32_t timestamp = (info.count == 0)
+        ? m_lastTime
+        : info.baseTime + static_cast<uint32_t>(info.count) * info.interval;
+    return Append(encoded, timestamp);
+}
+
+inline bool LogRing::Append(int16_t encoded, uint32_t timestamp) {
+    // Out of order: page base times would no longer be sorted for Query()
+    if (timestamp < m_lastTime) {
+        return false;
+    }
+
+    PageInfo info;
+    ParseInfo(m_page, info);
+
+    // Close the page if it is full (earlier write failed) or the sample
+    // does not fall on its cadence
+    bool closePage = (info.count >= SAMPLES_PER_PAGE);
+    if (info.count == 1) {
+        closePage = (timestamp < info.baseTime) || (timestamp - info.baseTime > 0xFFFF);
+    } else if (info.count > 1) {
+        closePage = closePage ||
+            (timestamp != info.baseTime + static_cast<uint32_t>(info.count) * info.interval);
+    }
+
+    if (closePage) {
+        if (!Flush()) {
+            return false;
+        }
+        AdvancePage();
+        info.count = 0;
+    }
+
+    if (info.count == 0) {
+        Put16(&m_page[4], static_cast<uint16_t>(timestamp >> 16));
+        Put16(&m_page[6], static_cast<uint16_t>(timestamp & 0xFFFF));
+        Put16(&m_page[8], 0);
+        Put16(&m_page[10], static_cast<uint16_t>(encoded));
+        Put16(&m_page[12], static_cast<uint16_t>(encoded));
+    } else {
+        if (info.count == 1) {
+            Put16(&m_page[8], static_cast<uint16_t>(timestamp - info.baseTime));
+        }
+        if (encoded < info.minValue) {
+            Put16(&m_page[10], static_cast<uint16_t>(encoded));
+        }
+        if (encoded > info.maxValue) {
+            Put16(&m_page[12], static_cast<uint16_t>(encoded));
+        }
+    }
+
+    uint8_t count = info.count;
+    uint8_t off = static_cast<uint8_t>(HEADER_SIZE + count * EEPROM24FC256::BYTES_PER_SAMPLE);
+    Put16(&m_page[off], static_cast<uint16_t>(encoded));
+    count++;
+    m_page[2] = count;
+    m_page[3] = HeaderCheck(m_seq, count);
+    m_dirty = true;
+    m_lastTime = timestamp;
+
+    if (count == SAMPLES_PER_PAGE) {
+        if (!Flush()) {
+            return false;
+        }
+        AdvancePage();
+    }
+    return true;
+}
+
+inline bool LogRing::Flush() {
+    if (!m_dirty) {
+        return true;
+    }
+
+    // Header and samples are contiguous: one page write, one write cycle
+    uint8_t len = static_cast<uint8_t>(HEADER_SIZE + m_page[2] * EEPROM24FC256::BYTES_PER_SAMPLE);
+    if (!m_eeprom.WritePage(PageAddress(m_head), m_page, len)) {
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+inline uint16_t LogRing::GetHeadPage() const {
+    return m_head;
+}
+
+inline uint16_t LogRing::GetSequence() const {
+    return m_seq;
+}
+
+inline uint8_t LogRing::GetHeadCount() const {
+    return m_page[2];
+}
+
+inline uint32_t LogRing::GetLastTime() const {
+    return m_lastTime;
+}
+
+inline uint16_t LogRing::GetUsedPages() const {
+    return m_wrapped ? m_pageCount : static_cast<uint16_t>(m_head + 1);
+}
+
+inline uint16_t LogRing::PhysicalPage(uint16_t age) const {
+    uint16_t used = GetUsedPages();
+    return static_cast<uint16_t>((m_head + 1 + m_pageCount - used + age) % m_pageCount);
+}
+
+inline bool LogRing::LoadPage(uint16_t age, const uint8_t*& data, uint8_t* buf) {
+    if (age >= GetUsedPages()) {
+        return false;
+    }
+
+    // Head page comes from RAM (may hold unflushed samples)
+    uint16_t page = PhysicalPage(age);
+    if (page == m_head) {
+        data = m_page;
+        return true;
+    }
+    if (!m_eeprom.ReadBytes(PageAddress(page), buf, PAGE_SIZE)) {
+        return false;
+    }
+    data = buf;
+    return data[2] <= SAMPLES_PER_PAGE;
+}
+
+inline bool LogRing::ReadPage(uint16_t age, int16_t* out, uint8_t& count) {
+    const uint8_t* data = nullptr;
+    uint8_t buf[PAGE_SIZE];
+
+    count = 0;
+    if (!LoadPage(age, data, buf)) {
+        return false;
+    }
+
+    count = data[2];
+    for (uint8_t i = 0; i < count; i++) {
+        out[i] = static_cast<int16_t>(Get16(&data[HEADER_SIZE + i * EEPROM24FC256::BYTES_PER_SAMPLE]));
+    }
+    return true;
+}
+
+inline bool LogRing::ReadPageInfo(uint16_t age, PageInfo& info) {
+    if (age >= GetUsedPages()) {
+        return false;
+    }
+
+    uint16_t page = PhysicalPage(age);
+    if (page == m_head) {
+        ParseInfo(m_page, info);
+        return true;
+    }
+
+    uint8_t hdr[HEADER_SIZE];
+    if (!m_eeprom.ReadBytes(PageAddress(page), hdr, HEADER_SIZE)) {
+        return false;
+    }
+    ParseInfo(hdr, info);
+    return info.count <= SAMPLES_PER_PAGE;
+}
+
+inline uint16_t LogRing::FindFirstPage(uint32_t t1) {
+    // Last page whose first sample is before t1 (page 0 if none), so pages
+    // sharing a base time equal to t1 are all scanned; empty pages (fresh
+    // head) sort after everything
+    uint16_t lo = 0;
+    uint16_t hi = static_cast<uint16_t>(GetUsedPages() - 1);
+    while (lo < hi) {
+        uint16_t mid = static_cast<uint16_t>((lo + hi + 1) / 2);
+        PageInfo info;
+        if (ReadPageInfo(mid, info) && info.count > 0 && info.baseTime < t1) {
+            lo = mid;
+        } else {
+            hi = static_cast<uint16_t>(mid - 1);
+        }
+    }
+    return lo;
+}
+
+inline uint16_t LogRing::Query(uint32_t t1, uint32_t t2, int16_t* out, uint16_t maxCount,
+                               uint32_t* times) {
+    uint16_t found = 0;
+    uint16_t used = GetUsedPages();
+    uint8_t buf[PAGE_SIZE];
+
+    for (uint16_t age = FindFirstPage(t1); age < used && found < maxCount; age++) {
+        const uint8_t* data = nullptr;
+        if (!LoadPage(age, data, buf)) {
+            break;
+        }
+
+        PageInfo info;
+        ParseInfo(data, info);
+        if (info.count == 0) {
+            continue;
+        }
+        if (info.baseTime > t2) {
+            break;  // Pages are in time order - nothing later can match
+        }
+
+        for (uint8_t i = 0; i < info.count && found < maxCount; i++) {
+            uint32_t t = info.baseTime + static_cast<uint32_t>(i) * info.interval;
+            if (t < t1 || t > t2) {
+                continue;
+            }
+            out[found] = static_cast<int16_t>(Get16(&data[HEADER_SIZE + i * EEPROM24FC256::BYTES_PER_SAMPLE]));
+            if (times != nullptr) {
+                times[found] = t;
+            }
+            found++;
+        }
+    }
+    return found;
+}
+
+inline bool LogRing::QueryMinMax(uint32_t t1, uint32_t t2, int16_t& minValue, int16_t& maxValue) {
+    bool any = false;
+    uint16_t used = GetUsedPages();
+
+    for (uint16_t age = FindFirstPage(t1); age < used; age++) {
+        PageInfo info;
+        if (!ReadPageInfo(age, info)) {
+            return false;
+        }
+        if (info.count == 0) {
+            continue;
+        }
+        if (info.baseTime > t2) {
+            break;
+        }
+
+        uint32_t lastTime = info.baseTime + static_cast<uint32_t>(info.count - 1) * info.interval;
+        if (info.baseTime >= t1 && lastTime <= t2) {
+            // Whole page inside the range: header summary is enough
+            if (!any || info.minValue < minValue) minValue = info.minValue;
+            if (!any || info.maxValue > maxValue) maxValue = info.maxValue;
+            any = true;
+            continue;
+        }
+
+        // Edge page: read its samples
+        int16_t samples[SAMPLES_PER_PAGE];
+        uint8_t count = 0;
+        if (!ReadPage(age, samples, count)) {
+            return false;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            uint32_t t = info.baseTime + static_cast<uint32_t>(i) * info.interval;
+            if (t < t1 || t > t2) {
+                continue;
+            }
+            if (!any || samples[i] < minValue) minValue = samples[i];
+            if (!any || samples[i] > maxValue) maxValue = samples[i];
+            any = true;
+        }
+    }
+    return any;
+}
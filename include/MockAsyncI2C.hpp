@@ -0,0 +1,157 @@
+/**
+ * @file MockAsyncI2C.hpp
+ * @brief Async I2C mock completing transfers from a simulated interrupt
+ *
+ * Wraps a synchronous device model (any II2CController, e.g. MockI2C or
+ * the test suite's RealI2CMock) behind IAsyncI2CController:
+ *
+ * - Submit() only queues; nothing touches the devices
+ * - Tick(bytes) plays the bus interrupt: it shifts that many bytes on the
+ *   wire, and when a transaction's last byte is out it runs it against the
+ *   device model, sets its status and calls the callback with
+ *   InInterrupt() true, then starts the next queued transaction
+ *
+ * Wire length counts the address byte, header, data and (for a read
+ * phase) the repeated-start address and rx bytes, so the caller controls
+ * how much bus time elapses between its own steps.
+ *
+ * On hardware the queue is shared with the I2C interrupt; a real
+ * controller masks that interrupt around queue updates in Submit().
+ */
+
+#pragma once
+#include "IAsyncI2CController.hpp"
+#include <cstdint>
+
+class MockAsyncI2C final : public IAsyncI2CController {
+public:
+    static constexpr uint8_t QUEUE_DEPTH = 4;
+
+    /// Transactions are executed against devices when they complete
+    explicit MockAsyncI2C(II2CController& devices);
+
+    bool Submit(I2CTransaction& t, I2CCallback done, void* context) override;
+
+    bool IsBusy() const override;
+
+    /// Simulated bus interrupt: move `bytes` bytes over the wire
+    void Tick(uint32_t bytes = 1);
+
+    /// Run the bus until the queue is empty (including transfers queued by callbacks)
+    void Drain();
+
+    /// True only while a completion callback is running
+    bool InInterrupt() const;
+
+    /// Transactions waiting or on the wire
+    uint8_t GetQueued() const;
+
+    /// Transactions completed so far
+    uint32_t GetCompleted() const;
+
+    /// Bytes shifted so far (bus time in byte periods)
+    uint32_t GetWireBytes() const;
+
+private:
+    struct Slot {
+        I2CTransaction* t;
+        I2CCallback done;
+        void* context;
+    };
+
+    II2CController& m_devices;
+    Slot m_queue[QUEUE_DEPTH];
+    uint8_t m_head;
+    uint8_t m_count;
+    uint32_t m_remaining;  ///< Bytes left of the head transaction (0 = not started)
+    bool m_inInterrupt;
+    uint32_t m_completed;
+    uint32_t m_wireBytes;
+
+    static uint32_t WireLength(const I2CTransaction& t);
+    void Complete();
+};
+
+// Inline implementations
+
+inline MockAsyncI2C::MockAsyncI2C(II2CController& devices)
+    : m_devices(devices), m_queue{}, m_head(0), m_count(0), m_remaining(0),
+      m_inInterrupt(false), m_completed(0), m_wireBytes(0) {
+}
+
+inline bool MockAsyncI2C::Submit(I2CTransaction& t, I2CCallback done, void* context) {
+    if (m_count == QUEUE_DEPTH) {
+        return false;
+    }
+    Slot& slot = m_queue[(m_head + m_count) % QUEUE_DEPTH];
+    slot.t = &t;
+    slot.done = done;
+    slot.context = context;
+    m_count++;
+    return true;
+}
+
+inline bool MockAsyncI2C::IsBusy() const {
+    return m_count > 0;
+}
+
+inline uint32_t MockAsyncI2C::WireLength(const I2CTransaction& t) {
+    uint32_t bytes = static_cast<uint32_t>(1 + t.headerLen + t.dataLen);
+    if (t.rxLen > 0) {
+        bytes += static_cast<uint32_t>(1 + t.rxLen);
+    }
+    return bytes;
+}
+
+inline void MockAsyncI2C::Tick(uint32_t bytes) {
+    while (bytes > 0 && m_count > 0) {
+        if (m_remaining == 0) {
+            m_remaining = WireLength(*m_queue[m_head].t);
+        }
+        uint32_t step = (bytes < m_remaining) ? bytes : m_remaining;
+        m_remaining -= step;
+        m_wireBytes += step;
+        bytes -= step;
+        if (m_remaining == 0) {
+            Complete();
+        }
+    }
+}
+
+inline void MockAsyncI2C::Drain() {
+    while (m_count > 0) {
+        Tick(WireLength(*m_queue[m_head].t));
+    }
+}
+
+inline void MockAsyncI2C::Complete() {
+    // Pop first: the callback may submit the next transfer
+    Slot slot = m_queue[m_head];
+    m_head = static_cast<uint8_t>((m_head + 1) % QUEUE_DEPTH);
+    m_count--;
+
+    m_devices.Transfer(slot.t, 1);
+    m_completed++;
+
+    m_inInterrupt = true;
+    if (slot.done != nullptr) {
+        slot.done(slot.context, *slot.t);
+    }
+    m_inInterrupt = false;
+}
+
+inline bool MockAsyncI2C::InInterrupt() const {
+    return m_inInterrupt;
+}
+
+inline uint8_t MockAsyncI2C::GetQueued() const {
+    return m_count;
+}
+
+inline uint32_t MockAsyncI2C::GetCompleted() const {
+    return m_completed;
+}
+
+inline uint32_t MockAsyncI2C::GetWireBytes() const {
+    return m_wireBytes;
+}
@@ -34,6 +34,19 @@ public:
      * If writing to address with data, enters write cycle state.
      */
     I2CStatus Write(const uint8_t* data, size_t len) {
+        size_t headerLen = len < 2 ? len : 2;
+        return Write(data, headerLen, data + headerLen, len - headerLen);
+    }
+    
+    /**
+     * @brief Gathered write: [header...][data...] as one transaction
+     * 
+     * Bytes are taken from the two spans in place (no staging copy); the
+     * first two bytes of the combined stream are the memory address.
+     */
+    I2CStatus Write(const uint8_t* header, size_t headerLen, const uint8_t* data, size_t dataLen) {
+        size_t len = headerLen + dataLen;
+        
         // If write cycle in progress, device doesn't ACK
         if (m_writeInProgress) {
             m_writeCycleCount++;
@@ -47,12 +60,18 @@ public:
             return I2CStatus::Nack;  // Still busy
         }
         
+        // ACK poll (address only): an idle device acknowledges
+        if (len == 0) {
+            return I2CStatus::OK;
+        }
+        
         // Parse address (first 2 bytes)
         if (len < 2) {
             return I2CStatus::Nack;
         }
         
-        uint16_t addr = ((uint16_t)data[0] << 8) | data[1];
+        uint16_t addr = ((uint16_t)ByteAt(header, headerLen, data, 0) << 8) |
+                        ByteAt(header, headerLen, data, 1);
         
         // Write data (if any after address)
         if (len > 2) {
@@ -65,7 +84,7 @@ public:
             
             // Write data to memory
             for (size_t i = 0; i < writeLen; i++) {
-                m_memory[addr + i] = data[2 + i];
+                m_memory[addr + i] = ByteAt(header, headerLen, data, 2 + i);
             }
             
             // Start write cycle (will NACK on next access until complete)
@@ -144,6 +163,11 @@ private:
     static constexpr uint16_t CAPACITY = 32768;  // 24FC256 = 32KB
     static constexpr uint8_t PAGE_SIZE = 64;
     
+    /// Byte i of a gathered write
+    static uint8_t ByteAt(const uint8_t* header, size_t headerLen, const uint8_t* data, size_t i) {
+        return i < headerLen ? header[i] : data[i - headerLen];
+    }
+    
     uint8_t m_memory[CAPACITY];      // Internal memory buffer
     bool m_writeInProgress;          // Write cycle state
     uint32_t m_writeCycleCount;      // Cycles elapsed in write
@@ -9,6 +9,9 @@
  * - 0x48: TMP100 temperature sensor (MockTMP100)
  * - 0x50: 24FC256 EEPROM (MockEEPROM)
  * 
+ * Declared final: drivers instantiated over MockI2C itself (TMP100T<MockI2C>,
+ * EEPROM24FC256T<MockI2C>) call it without virtual dispatch.
+ * 
  * IMPORTANT:
  * MockI2C would be replaced with STM32's I2C controller on real hardware. 
  * For testing, test_logger.cpp implements a realistic I2C mock (RealI2CMock) that simulates device behavior.
@@ -19,7 +22,7 @@
 #include "MockEEPROM.hpp"
 #include <cstdint>
 
-class MockI2C : public II2CController {
+class MockI2C final : public II2CController {
 public:
     MockI2C() {
         // No hardware initialization needed
@@ -73,6 +76,36 @@ public:
         return I2CStatus::Nack;
     }
     
+    I2CStatus WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                     const uint8_t* data, size_t dataLen) override {
+        if (addr == 0x50) {
+            // 24FC256 EEPROM: address and page data taken in place
+            return m_eeprom.Write(header, headerLen, data, dataLen);
+        }
+        return I2CStatus::Nack;  // No mock TMP100 yet
+    }
+    
+    I2CStatus Transfer(I2CTransaction* list, size_t count) override {
+        // Same dispatch as the default, without a virtual call per entry
+        I2CStatus result = I2CStatus::OK;
+        for (size_t i = 0; i < count; i++) {
+            I2CTransaction& t = list[i];
+            if (t.rxLen == 0) {
+                t.status = MockI2C::WriteV(t.addr, t.header, t.headerLen, t.data, t.dataLen);
+            } else if (t.dataLen != 0) {
+                t.status = I2CStatus::Error;
+            } else if (t.headerLen == 0) {
+                t.status = MockI2C::Read(t.addr, t.rx, t.rxLen);
+            } else {
+                t.status = MockI2C::WriteRead(t.addr, t.header, t.headerLen, t.rx, t.rxLen);
+            }
+            if (result == I2CStatus::OK) {
+                result = t.status;
+            }
+        }
+        return result;
+    }
+    
     // Test helper: access EEPROM mock directly
     MockEEPROM& GetEEPROMMock() {
         return m_eeprom;
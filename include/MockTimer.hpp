@@ -5,7 +5,7 @@
  * Allows manual control of time progression:
  * - Tests can advance time without waiting
  * - Verifies 10-minute logging interval logic
- * - Does not actually wait 10 minutes. Time is simulated. Real hardware would use SysTick / interrupts.
+ * - Does not actually wait 10 minutes. Time is simulated. Real hardware uses SysTickTimer.
  * 
  * Usage in tests:
  *   MockTimer timer;
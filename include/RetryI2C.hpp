@@ -0,0 +1,312 @@
+/**
+ * @file RetryI2C.hpp
+ * @brief Retry/backoff layer between the drivers and the bus
+ *
+ * The drivers give up on the first non-OK I2CStatus, so a single glitch
+ * on the bus (EMI on a long sensor cable, a device busy for a moment)
+ * costs a sample. RetryI2CT<Bus> is an II2CController that forwards to
+ * Bus and repeats failed transactions:
+ *
+ * - Up to RetryPolicy::maxRetries extra attempts, with an exponential
+ *   backoff (backoffTicks, doubling, capped at maxBackoffTicks) waited
+ *   through a hook in the caller's timer ticks
+ * - After Timeout or Error (a bus fault rather than a device answer) the
+ *   bus-reset hook runs before the next attempt (on the STM32: clock SCL
+ *   until SDA is released, then reinitialize the peripheral)
+ * - Zero-length writes are ACK polls: their NACK means "write cycle still
+ *   running" and is passed straight back to the EEPROM driver
+ * - A device that has failed deadAfter transactions in a row (absent or
+ *   unpowered) gets a single attempt per transaction and no backoff until
+ *   it answers again, so a missing sensor does not cost retries on every
+ *   sweep
+ *
+ * Transfer() batches go to the bus as one batch; only the entries that
+ * failed are retried, one by one.
+ *
+ * Per-device counters (I2CDeviceStats) count NACKs, timeouts and errors
+ * per attempt, retries, recoveries and failures, plus the bytes re-sent
+ * and ticks waited by retries, i.e. the bus time the retries cost.
+ *
+ * Hooks are plain function pointers with a context pointer, as for
+ * I2CCallback: no allocation.
+ */
+
+#pragma once
+#include "II2CController.hpp"
+#include <cstdint>
+#include <cstddef>
+
+struct RetryPolicy {
+    uint8_t  maxRetries;       ///< Attempts after the first
+    uint16_t backoffTicks;     ///< Wait before the first retry
+    uint16_t maxBackoffTicks;  ///< Cap of the doubling wait
+    uint8_t  deadAfter;        ///< Failed transactions in a row before retries stop (0 = never)
+};
+
+struct RetryHooks {
+    void (*wait)(void* context, uint32_t ticks);  ///< Backoff delay (nullptr: retry at once)
+    void (*resetBus)(void* context);              ///< Bus recovery (nullptr: none)
+    void* context;
+};
+
+/// Counters of one device address
+struct I2CDeviceStats {
+    uint8_t  addr;
+    uint32_t transactions;    ///< Calls from the drivers
+    uint32_t nacks;           ///< Attempts NACKed
+    uint32_t timeouts;        ///< Attempts timed out
+    uint32_t errors;          ///< Attempts with a bus error
+    uint32_t retries;         ///< Attempts after the first
+    uint32_t recovered;       ///< Transactions that succeeded on a retry
+    uint32_t failures;        ///< Transactions that failed after every attempt
+    uint32_t retryWireBytes;  ///< Bytes (address included) re-sent by retries
+    uint32_t backoffTicks;    ///< Ticks waited before retries
+    uint8_t  failStreak;      ///< Transactions failed in a row
+};
+
+template <typename Bus = II2CController>
+class RetryI2CT final : public II2CController {
+public:
+    static constexpr uint8_t MAX_DEVICES = 8;  ///< Tracked addresses; others share one entry
+    static constexpr RetryPolicy DEFAULT_POLICY = { 3, 1, 8, 3 };
+
+    RetryI2CT(Bus& bus, const RetryPolicy& policy = DEFAULT_POLICY,
+              const RetryHooks& hooks = RetryHooks{ nullptr, nullptr, nullptr });
+
+    I2CStatus Write(uint8_t addr, const uint8_t* data, size_t len) override;
+    I2CStatus Read(uint8_t addr, uint8_t* buffer, size_t len) override;
+    I2CStatus WriteRead(uint8_t addr, const uint8_t* tx, size_t txLen,
+                        uint8_t* rx, size_t rxLen) override;
+    I2CStatus WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                     const uint8_t* data, size_t dataLen) override;
+    I2CStatus Transfer(I2CTransaction* list, size_t count) override;
+
+    void SetPolicy(const RetryPolicy& policy);
+
+    /// Counters of addr (nullptr if never addressed)
+    const I2CDeviceStats* GetStats(uint8_t addr) const;
+
+    /// Sum over all devices (addr = 0xFF, failStreak unused)
+    I2CDeviceStats GetTotals() const;
+
+    /// Bus-reset hook invocations
+    uint32_t GetBusResets() const;
+
+    /// Zero all counters (a dead device gets retries again)
+    void ResetStats();
+
+private:
+    static constexpr uint8_t OTHER = 0xFF;  ///< Address of the shared overflow entry
+
+    Bus& m_bus;
+    RetryPolicy m_policy;
+    RetryHooks m_hooks;
+    I2CDeviceStats m_stats[MAX_DEVICES + 1];
+    uint8_t m_devices;
+    uint32_t m_busResets;
+
+    I2CDeviceStats& Stats(uint8_t addr);
+
+    /// Count one attempt's outcome
+    static void Count(I2CDeviceStats& s, I2CStatus status);
+
+    /**
+     * @brief Retry after a failed first attempt
+     * @param attempt Callable re-running the transaction, returns its status
+     */
+    template <typename Attempt>
+    I2CStatus Retry(I2CDeviceStats& s, I2CStatus first, size_t wireBytes, Attempt attempt);
+
+    template <typename Attempt>
+    I2CStatus Run(uint8_t addr, size_t wireBytes, Attempt attempt);
+};
+
+/// Retry layer over the virtual II2CController interface
+using RetryI2C = RetryI2CT<II2CController>;
+
+// Inline implementations
+
+template <typename Bus>
+constexpr RetryPolicy RetryI2CT<Bus>::DEFAULT_POLICY;
+
+template <typename Bus>
+inline RetryI2CT<Bus>::RetryI2CT(Bus& bus, const RetryPolicy& policy, const RetryHooks& hooks)
+    : m_bus(bus), m_policy(policy), m_hooks(hooks), m_stats{}, m_devices(0), m_busResets(0) {
+}
+
+template <typename Bus>
+inline I2CDeviceStats& RetryI2CT<Bus>::Stats(uint8_t addr) {
+    for (uint8_t i = 0; i < m_devices; i++) {
+        if (m_stats[i].addr == addr) {
+            return m_stats[i];
+        }
+    }
+    if (m_devices < MAX_DEVICES) {
+        m_stats[m_devices].addr = addr;
+        return m_stats[m_devices++];
+    }
+    m_stats[MAX_DEVICES].addr = OTHER;
+    return m_stats[MAX_DEVICES];
+}
+
+template <typename Bus>
+inline void RetryI2CT<Bus>::Count(I2CDeviceStats& s, I2CStatus status) {
+    if (status == I2CStatus::Nack) {
+        s.nacks++;
+    } else if (status == I2CStatus::Timeout) {
+        s.timeouts++;
+    } else if (status == I2CStatus::Error) {
+        s.errors++;
+    }
+}
+
+template <typename Bus>
+template <typename Attempt>
+inline I2CStatus RetryI2CT<Bus>::Retry(I2CDeviceStats& s, I2CStatus first, size_t wireBytes,
+                                       Attempt attempt) {
+    Count(s, first);
+    I2CStatus status = first;
+    bool dead = m_policy.deadAfter != 0 && s.failStreak >= m_policy.deadAfter;
+    uint32_t backoff = m_policy.backoffTicks;
+
+    for (uint8_t r = 0; status != I2CStatus::OK && !dead && r < m_policy.maxRetries; r++) {
+        if (status != I2CStatus::Nack && m_hooks.resetBus != nullptr) {
+            m_hooks.resetBus(m_hooks.context);
+            m_busResets++;
+        }
+        if (backoff > 0 && m_hooks.wait != nullptr) {
+            m_hooks.wait(m_hooks.context, backoff);
+            s.backoffTicks += backoff;
+        }
+        backoff = (backoff * 2 < m_policy.maxBackoffTicks) ? backoff * 2 : m_policy.maxBackoffTicks;
+
+        s.retries++;
+        s.retryWireBytes += static_cast<uint32_t>(wireBytes);
+        status = attempt();
+        Count(s, status);
+        if (status == I2CStatus::OK) {
+            s.recovered++;
+        }
+    }
+
+    if (status == I2CStatus::OK) {
+        s.failStreak = 0;
+    } else {
+        s.failures++;
+        if (s.failStreak < UINT8_MAX) {
+            s.failStreak++;
+        }
+    }
+    return status;
+}
+
+template <typename Bus>
+template <typename Attempt>
+inline I2CStatus RetryI2CT<Bus>::Run(uint8_t addr, size_t wireBytes, Attempt attempt) {
+    I2CDeviceStats& s = Stats(addr);
+    s.transactions++;
+    return Retry(s, attempt(), wireBytes, attempt);
+}
+
+template <typename Bus>
+inline I2CStatus RetryI2CT<Bus>::Write(uint8_t addr, const uint8_t* data, size_t len) {
+    if (len == 0) {
+        return m_bus.Write(addr, data, len);  // ACK poll: a NACK is the answer
+    }
+    return Run(addr, 1 + len, [&]() { return m_bus.Write(addr, data, len); });
+}
+
+template <typename Bus>
+inline I2CStatus RetryI2CT<Bus>::Read(uint8_t addr, uint8_t* buffer, size_t len) {
+    return Run(addr, 1 + len, [&]() { return m_bus.Read(addr, buffer, len); });
+}
+
+template <typename Bus>
+inline I2CStatus RetryI2CT<Bus>::WriteRead(uint8_t addr, const uint8_t* tx, size_t txLen,
+                                           uint8_t* rx, size_t rxLen) {
+    return Run(addr, 2 + txLen + rxLen, [&]() { return m_bus.WriteRead(addr, tx, txLen, rx, rxLen); });
+}
+
+template <typename Bus>
+inline I2CStatus RetryI2CT<Bus>::WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                                        const uint8_t* data, size_t dataLen) {
+    if (headerLen + dataLen == 0) {
+        return m_bus.WriteV(addr, header, headerLen, data, dataLen);
+    }
+    return Run(addr, 1 + headerLen + dataLen,
+               [&]() { return m_bus.WriteV(addr, header, headerLen, data, dataLen); });
+}
+
+template <typename Bus>
+inline I2CStatus RetryI2CT<Bus>::Transfer(I2CTransaction* list, size_t count) {
+    m_bus.Transfer(list, count);
+
+    I2CStatus result = I2CStatus::OK;
+    for (size_t i = 0; i < count; i++) {
+        I2CTransaction& t = list[i];
+        I2CDeviceStats& s = Stats(t.addr);
+        s.transactions++;
+        size_t tx = t.headerLen + t.dataLen;
+        if (tx == 0 && t.rxLen == 0) {
+            Count(s, t.status);  // ACK poll
+        } else {
+            size_t wire = 1 + tx + t.rxLen + ((tx > 0 && t.rxLen > 0) ? 1 : 0);
+            t.status = Retry(s, t.status, wire, [&]() {
+                m_bus.Transfer(&t, 1);
+                return t.status;
+            });
+        }
+        if (result == I2CStatus::OK) {
+            result = t.status;
+        }
+    }
+    return result;
+}
+
+template <typename Bus>
+inline void RetryI2CT<Bus>::SetPolicy(const RetryPolicy& policy) {
+    m_policy = policy;
+}
+
+template <typename Bus>
+inline const I2CDeviceStats* RetryI2CT<Bus>::GetStats(uint8_t addr) const {
+    for (uint8_t i = 0; i < m_devices; i++) {
+        if (m_stats[i].addr == addr) {
+            return &m_stats[i];
+        }
+    }
+    return nullptr;
+}
+
+template <typename Bus>
+inline I2CDeviceStats RetryI2CT<Bus>::GetTotals() const {
+    I2CDeviceStats total{};
+    total.addr = OTHER;
+    for (uint8_t i = 0; i <= MAX_DEVICES; i++) {
+        const I2CDeviceStats& s = m_stats[i];
+        total.transactions += s.transactions;
+        total.nacks += s.nacks;
+        total.timeouts += s.timeouts;
+        total.errors += s.errors;
+        total.retries += s.retries;
+        total.recovered += s.recovered;
+        total.failures += s.failures;
+        total.retryWireBytes += s.retryWireBytes;
+        total.backoffTicks += s.backoffTicks;
+    }
+    return total;
+}
+
+template <typename Bus>
+inline uint32_t RetryI2CT<Bus>::GetBusResets() const {
+    return m_busResets;
+}
+
+template <typename Bus>
+inline void RetryI2CT<Bus>::ResetStats() {
+    for (uint8_t i = 0; i <= MAX_DEVICES; i++) {
+        m_stats[i] = I2CDeviceStats{};
+    }
+    m_devices = 0;
+    m_busResets = 0;
+}
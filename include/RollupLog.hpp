@@ -0,0 +1,402 @@
+/**
+ * @file RollupLog.hpp
+ * @brief Tiered storage: raw sample ring plus hourly and daily rollups
+ *
+ * The raw LogRing on its own keeps only the newest few weeks; once it
+ * wraps, older history is gone. RollupLog splits the 24FC256 into three
+ * regions and keeps min/mean/max summaries of every hour and every day
+ * next to the raw ring, so trends survive for years:
+ *
+ *   region   default pages  contents                   retention @ 10 min
+ *   raw      192            LogRing pages (25 samples)  4800 samples, 33 days
+ *   hourly   192            1536 hourly records         64 days
+ *   daily    128            1024 daily records          2.8 years
+ *
+ * Record layout (8 bytes, big-endian, 8 per page, never straddle a page):
+ *   [0..1]  period index (timestamp / period length) modulo 0xFFFF;
+ *           0xFFFF never occurs, so erased slots never match a period
+ *   [2..3]  min sample, Q12.4
+ *   [4..5]  mean sample, Q12.4 (rounded)
+ *   [6..7]  max sample, Q12.4
+ *
+ * Period p lives in slot p % slots of its region, so a tier is a ring
+ * addressed by time: no index or head pointer has to be stored, and a
+ * slot whose period field does not match holds no data for that period.
+ *
+ * Rollups are computed incrementally in fixed point as samples arrive:
+ * each open period keeps an int32 sum, a count and min/max in RAM, and
+ * the record is written when the first sample of the next period
+ * arrives (one 8-byte page write). Flush() also writes the open periods
+ * so a reset loses nothing; Recover() rebuilds their accumulators from
+ * the raw samples of the open hour and day.
+ *
+ * Timestamps must not go backwards (see LogRing). A timer that restarts
+ * at 0 on every reset has to be offset by GetLastTime() after Recover().
+ *
+ * A query over a year of daily data reads 365 records (2920 bytes) in
+ * at most two transactions instead of ~52000 raw samples.
+ */
+
+#pragma once
+#include "EEPROM24FC256.hpp"
+#include "LogRing.hpp"
+#include <cstdint>
+
+class RollupLog {
+public:
+    static constexpr uint8_t  PAGE_SIZE   = EEPROM24FC256::PAGE_SIZE;
+    static constexpr uint8_t  RECORD_SIZE = 8;
+    static constexpr uint8_t  RECORDS_PER_PAGE = PAGE_SIZE / RECORD_SIZE;
+    static constexpr uint16_t DEVICE_PAGES = EEPROM24FC256::CAPACITY / PAGE_SIZE;
+
+    static constexpr uint16_t DEFAULT_RAW_PAGES    = 192;
+    static constexpr uint16_t DEFAULT_HOURLY_PAGES = 192;
+    static constexpr uint16_t DEFAULT_DAILY_PAGES  = 128;
+
+    static constexpr uint32_t HOUR_SECONDS = 3600;
+    static constexpr uint32_t DAY_SECONDS  = 86400;
+
+    enum class Tier : uint8_t {
+        Hourly = 0,
+        Daily  = 1
+    };
+
+    /// One rollup record (same size as its EEPROM image)
+    struct Record {
+        uint16_t period;     ///< Period index modulo 0xFFFF
+        int16_t  minValue;   ///< Q12.4
+        int16_t  meanValue;  ///< Q12.4, rounded
+        int16_t  maxValue;   ///< Q12.4
+    };
+
+    /**
+     * @brief Lay out the three regions back to back from page 0
+     *
+     * rawPages + hourlyPages + dailyPages must not exceed DEVICE_PAGES.
+     */
+    RollupLog(EEPROM24FC256& eeprom,
+              uint16_t rawPages = DEFAULT_RAW_PAGES,
+              uint16_t hourlyPages = DEFAULT_HOURLY_PAGES,
+              uint16_t dailyPages = DEFAULT_DAILY_PAGES);
+
+    /**
+     * @brief Recover the raw ring head and the open hour/day after a reset
+     *
+     * The accumulators of the periods holding the newest raw sample are
+     * rebuilt from the raw ring with time-indexed queries.
+     *
+     * @return false on I2C error
+     */
+    bool Recover();
+
+    /// Log one Q12.4 sample taken at timestamp (seconds) to all tiers;
+    /// closes and writes hourly/daily records when a period ends
+    /// Returns false if timestamp is older than GetLastTime() (nothing is
+    /// logged) or any EEPROM write failed
+    bool Append(int16_t encoded, uint32_t timestamp);
+
+    /// Same as Append(temp.Raw(), timestamp)
+    bool Append(Temperature temp, uint32_t timestamp);
+
+    /// Write the raw head page and the records of the open periods
+    bool Flush();
+
+    /// Raw sample ring (for sample-level queries)
+    LogRing& GetRaw();
+
+    /// Timestamp of the newest sample (0 if none); after Recover() the
+    /// time base new samples have to continue from
+    uint32_t GetLastTime() const;
+
+    /// Number of record slots (= periods retained) in a tier
+    uint16_t GetSlots(Tier tier) const;
+
+    /**
+     * @brief Rollup records of the periods overlapping [t1, t2]
+     *
+     * Records are read straight into out[] with one sequential read (two
+     * if the slot range wraps) and decoded in place. Periods older than
+     * the tier's retention or without data are skipped; the open period
+     * is answered from RAM.
+     *
+     * @param out Room for maxCount records
+     * @return Number of records stored, oldest first
+     */
+    uint16_t Query(Tier tier, uint32_t t1, uint32_t t2, Record* out, uint16_t maxCount);
+
+private:
+    static_assert(sizeof(Record) == RECORD_SIZE, "Record is decoded in place");
+
+    static constexpr uint8_t  TIER_COUNT = 2;
+    static constexpr uint32_t NO_PERIOD  = 0xFFFF;
+
+    /// Region and running accumulator of one tier
+    struct TierState {
+        uint16_t firstPage;
+        uint16_t slots;
+        uint32_t seconds;   ///< Period length
+        uint32_t period;    ///< Open period index
+        uint16_t count;     ///< Samples in the open period (0 = none)
+        int32_t  sum;       ///< Sum of samples, Q12.4
+        int16_t  minValue;
+        int16_t  maxValue;
+        bool     dirty;     ///< Open record not yet written
+    };
+
+    EEPROM24FC256& m_eeprom;
+    LogRing m_raw;
+    TierState m_tiers[TIER_COUNT];
+
+    static uint16_t StoredPeriod(uint32_t period);
+    static void MakeRecord(const TierState& s, Record& rec);
+    static void Accumulate(TierState& s, int16_t encoded);
+    uint16_t SlotAddress(const TierState& s, uint32_t period) const;
+    bool WriteRecord(TierState& s);
+    bool AppendToTier(TierState& s, int16_t encoded, uint32_t timestamp);
+    void Reaccumulate(TierState& s, uint32_t lastTime);
+};
+
+// Inline implementations
+
+inline RollupLog::RollupLog(EEPROM24FC256& eeprom,
+                            uint16_t rawPages,
+                            uint16_t hourlyPages,
+                            uint16_t dailyPages)
+    : m_eeprom(eeprom), m_raw(eeprom, 0, rawPages), m_tiers{} {
+    m_tiers[0].firstPage = rawPages;
+    m_tiers[0].slots = static_cast<uint16_t>(hourlyPages * RECORDS_PER_PAGE);
+    m_tiers[0].seconds = HOUR_SECONDS;
+    m_tiers[1].firstPage = static_cast<uint16_t>(rawPages + hourlyPages);
+    m_tiers[1].slots = static_cast<uint16_t>(dailyPages * RECORDS_PER_PAGE);
+    m_tiers[1].seconds = DAY_SECONDS;
+}
+
+inline LogRing& RollupLog::GetRaw() {
+    return m_raw;
+}
+
+inline uint32_t RollupLog::GetLastTime() const {
+    return m_raw.GetLastTime();
+}
+
+inline uint16_t RollupLog::GetSlots(Tier tier) const {
+    return m_tiers[static_cast<uint8_t>(tier)].slots;
+}
+
+inline uint16_t RollupLog::StoredPeriod(uint32_t period) {
+    return static_cast<uint16_t>(period % NO_PERIOD);
+}
+
+inline uint16_t RollupLog::SlotAddress(const TierState& s, uint32_t period) const {
+    uint16_t slot = static_cast<uint16_t>(period % s.slots);
+    return static_cast<uint16_t>(s.firstPage * PAGE_SIZE + slot * RECORD_SIZE);
+}
+
+inline void RollupLog::MakeRecord(const TierState& s, Record& rec) {
+    // Round half away from zero so the mean is unbiased for negative data
+    int32_t half = s.count / 2;
+    int32_t mean = (s.sum >= 0 ? s.sum + half : s.sum - half) / s.count;
+
+    rec.period = StoredPeriod(s.period);
+    rec.minValue = s.minValue;
+    rec.meanValue = static_cast<int16_t>(mean);
+    rec.maxValue = s.maxValue;
+}
+
+inline void RollupLog::Accumulate(TierState& s, int16_t encoded) {
+    if (s.count == 0) {
+        s.sum = 0;
+        s.minValue = encoded;
+        s.maxValue = encoded;
+    }
+    s.sum += encoded;
+    s.count++;
+    if (encoded < s.minValue) s.minValue = encoded;
+    if (encoded > s.maxValue) s.maxValue = encoded;
+    s.dirty = true;
+}
+
+inline bool RollupLog::WriteRecord(TierState& s) {
+    if (s.slots == 0 || s.count == 0) {
+        return true;
+    }
+
+    Record rec;
+    MakeRecord(s, rec);
+    uint8_t data[RECORD_SIZE] = {
+        static_cast<uint8_t>(rec.period >> 8),
+        static_cast<uint8_t>(rec.period & 0xFF),
+        static_cast<uint8_t>(static_cast<uint16_t>(rec.minValue) >> 8),
+        static_cast<uint8_t>(rec.minValue & 0xFF),
+        static_cast<uint8_t>(static_cast<uint16_t>(rec.meanValue) >> 8),
+        static_cast<uint8_t>(rec.meanValue & 0xFF),
+        static_cast<uint8_t>(static_cast<uint16_t>(rec.maxValue) >> 8),
+        static_cast<uint8_t>(rec.maxValue & 0xFF)
+    };
+
+    if (!m_eeprom.WritePage(SlotAddress(s, s.period), data, RECORD_SIZE)) {
+        return false;
+    }
+    s.dirty = false;
+    return true;
+}
+
+inline bool RollupLog::AppendToTier(TierState& s, int16_t encoded, uint32_t timestamp) {
+    uint32_t period = timestamp / s.seconds;
+    bool ok = true;
+
+    if (s.count > 0 && period != s.period) {
+        // First sample of a new period closes the previous one; if that
+        // write fails its record is lost but the new period still starts
+        ok = !s.dirty || WriteRecord(s);
+        s.count = 0;
+    }
+
+    s.period = period;
+    Accumulate(s, encoded);
+    return ok;
+}
+
+inline bool RollupLog::Append(int16_t encoded, uint32_t timestamp) {
+    // An older sample would reopen a closed period over its record
+    if (timestamp < m_raw.GetLastTime()) {
+        return false;
+    }
+
+    bool ok = m_raw.Append(encoded, timestamp);
+    for (uint8_t t = 0; t < TIER_COUNT; t++) {
+        ok = AppendToTier(m_tiers[t], encoded, timestamp) && ok;
+    }
+    return ok;
+}
+
+inline bool RollupLog::Append(Temperature temp, uint32_t timestamp) {
+    return Append(temp.Raw(), timestamp);
+}
+
+inline bool RollupLog::Flush() {
+    bool ok = m_raw.Flush();
+    for (uint8_t t = 0; t < TIER_COUNT; t++) {
+        if (m_tiers[t].dirty) {
+            ok = WriteRecord(m_tiers[t]) && ok;
+        }
+    }
+    return ok;
+}
+
+inline void RollupLog::Reaccumulate(TierState& s, uint32_t lastTime) {
+    s.period = lastTime / s.seconds;
+    s.count = 0;
+
+    // Re-read the raw samples of the open period, one page per query
+    int16_t samples[LogRing::SAMPLES_PER_PAGE];
+    uint32_t times[LogRing::SAMPLES_PER_PAGE];
+    uint32_t t = s.period * s.seconds;
+    uint32_t end = t + s.seconds - 1;
+
+    for (;;) {
+        uint16_t n = m_raw.Query(t, end, samples, LogRing::SAMPLES_PER_PAGE, times);
+        for (uint16_t i = 0; i < n; i++) {
+            Accumulate(s, samples[i]);
+        }
+        if (n < LogRing::SAMPLES_PER_PAGE || times[n - 1] >= end) {
+            break;
+        }
+        t = times[n - 1] + 1;
+    }
+
+    // The record on the device may predate the last samples before the
+    // reset (raw page flushed, record not): rewrite it when the period
+    // closes or at the next Flush()
+    s.dirty = (s.count > 0);
+}
+
+inline bool RollupLog::Recover() {
+    if (!m_raw.Recover()) {
+        return false;
+    }
+    for (uint8_t t = 0; t < TIER_COUNT; t++) {
+        m_tiers[t].count = 0;
+        m_tiers[t].dirty = false;
+    }
+
+    // Newest sample: in the head page, or the page before a fresh head
+    LogRing::PageInfo info;
+    uint16_t used = m_raw.GetUsedPages();
+    if (!m_raw.ReadPageInfo(static_cast<uint16_t>(used - 1), info)) {
+        return false;
+    }
+    if (info.count == 0) {
+        if (used < 2) {
+            return true;  // Empty log
+        }
+        if (!m_raw.ReadPageInfo(static_cast<uint16_t>(used - 2), info)) {
+            return false;
+        }
+        if (info.count == 0) {
+            return true;
+        }
+    }
+
+    uint32_t lastTime = info.baseTime + static_cast<uint32_t>(info.count - 1) * info.interval;
+    for (uint8_t t = 0; t < TIER_COUNT; t++) {
+        Reaccumulate(m_tiers[t], lastTime);
+    }
+    return true;
+}
+
+inline uint16_t RollupLog::Query(Tier tier, uint32_t t1, uint32_t t2, Record* out, uint16_t maxCount) {
+    const TierState& s = m_tiers[static_cast<uint8_t>(tier)];
+    if (t2 < t1 || maxCount == 0 || s.slots == 0) {
+        return 0;
+    }
+
+    // Periods to fetch, limited to the tier's retention and to out[]
+    uint32_t p1 = t1 / s.seconds;
+    uint32_t p2 = t2 / s.seconds;
+    if (p2 - p1 >= s.slots) {
+        p1 = p2 - s.slots + 1;
+    }
+    if (p2 - p1 >= maxCount) {
+        p2 = p1 + maxCount - 1;
+    }
+    uint16_t n = static_cast<uint16_t>(p2 - p1 + 1);
+
+    // Slots are contiguous in the region apart from one possible wrap
+    uint8_t* raw = reinterpret_cast<uint8_t*>(out);
+    uint16_t firstSlot = static_cast<uint16_t>(p1 % s.slots);
+    uint16_t firstRun = static_cast<uint16_t>(s.slots - firstSlot);
+    if (firstRun > n) {
+        firstRun = n;
+    }
+    if (!m_eeprom.ReadBytes(SlotAddress(s, p1), raw,
+                            static_cast<uint32_t>(firstRun) * RECORD_SIZE)) {
+        return 0;
+    }
+    if (n > firstRun &&
+        !m_eeprom.ReadBytes(SlotAddress(s, 0), raw + firstRun * RECORD_SIZE,
+                            static_cast<uint32_t>(n - firstRun) * RECORD_SIZE)) {
+        return 0;
+    }
+
+    // Decode in place and drop slots that hold another (or no) period;
+    // record i's bytes are read before anything at or after i is written
+    uint16_t found = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        const uint8_t* b = &raw[i * RECORD_SIZE];
+        Record rec;
+        rec.period = static_cast<uint16_t>((b[0] << 8) | b[1]);
+        rec.minValue = static_cast<int16_t>((b[2] << 8) | b[3]);
+        rec.meanValue = static_cast<int16_t>((b[4] << 8) | b[5]);
+        rec.maxValue = static_cast<int16_t>((b[6] << 8) | b[7]);
+
+        uint32_t period = p1 + i;
+        if (s.count > 0 && period == s.period) {
+            MakeRecord(s, rec);  // Open period: RAM is newer than EEPROM
+        } else if (rec.period != StoredPeriod(period)) {
+            continue;
+        }
+        out[found++] = rec;
+    }
+    return found;
+}
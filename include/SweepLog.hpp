@@ -0,0 +1,359 @@
+/**
+ * @file SweepLog.hpp
+ * @brief Power-fail safe ring of fixed-size multi-channel records
+ *
+ * TMP100Array::LogSweep() produces one record per sweep. Staged through
+ * an EEPROMPageWriter those records have no recoverable write position:
+ * after a reset the writer starts over at its first address. SweepLog
+ * stores whole records in sequence-numbered pages like LogRing, so
+ * Recover() finds the write head with the same binary search over page
+ * headers and logging continues where it stopped.
+ *
+ * Page layout (64 bytes):
+ *   [0..1]  sequence number, big-endian (wraps at 65536)
+ *   [2]     record count in this page
+ *   [3]     record size in bytes (a ring laid out for another record
+ *           size is treated as empty)
+ *   [4]     check byte: seq_hi ^ seq_lo ^ count ^ size ^ 0xA5 (rejects
+ *           erased 0xFF pages and torn headers)
+ *   [5..]   records, (PAGE_SIZE - 5) / size per page; records never
+ *           straddle a page
+ *
+ * Records start with their timestamp (seconds, high word first) as
+ * TMP100Array records do. Timestamps must not go backwards: Append()
+ * rejects a record older than the newest one, and Recover() restores
+ * that limit from the head page, so a timer that restarts at 0 on every
+ * reset has to be offset by GetLastTime().
+ *
+ * Records are staged in a RAM image of the head page. A full page is
+ * written with one page write; Flush() writes the partial head page so
+ * it survives a reset.
+ */
+
+#pragma once
+#include "EEPROM24FC256.hpp"
+#include <cstdint>
+
+class SweepLog {
+public:
+    static constexpr uint8_t  PAGE_SIZE    = EEPROM24FC256::PAGE_SIZE;
+    static constexpr uint8_t  HEADER_SIZE  = 5;
+    static constexpr uint8_t  TIME_BYTES   = 4;
+    static constexpr uint16_t DEVICE_PAGES = EEPROM24FC256::CAPACITY / PAGE_SIZE;
+
+    /**
+     * @brief Ring of recordBytes-sized records in pages [firstPage, firstPage + pageCount)
+     *
+     * recordBytes must hold the timestamp and fit a page after the header
+     * (TIME_BYTES .. PAGE_SIZE - HEADER_SIZE); otherwise every Append() fails.
+     */
+    SweepLog(EEPROM24FC256& eeprom, uint8_t recordBytes,
+             uint16_t firstPage = 0, uint16_t pageCount = DEVICE_PAGES);
+
+    /**
+     * @brief Locate the write head after a reset
+     *
+     * Binary search for the last page whose sequence number continues
+     * the run started by the first page, then reload that page into RAM.
+     * A ring with no valid first page is treated as empty.
+     *
+     * @return false on I2C error
+     */
+    bool Recover();
+
+    /**
+     * @brief Stage one record of count big-endian words
+     *
+     * Writes the page when it becomes full.
+     *
+     * @return false if the record has the wrong size or is older than
+     *         GetLastTime() (nothing is staged), or a page write failed
+     *         (the page stays in RAM and the next Append() or Flush()
+     *         retries it)
+     */
+    bool AppendRecord(const int16_t* words, uint8_t count);
+
+    /// Write the staged head page (header + records) to EEPROM
+    bool Flush();
+
+    /// Record size in bytes
+    uint8_t GetRecordBytes() const;
+
+    /// Records that fit one page
+    uint8_t GetRecordsPerPage() const;
+
+    /// Head page, relative to firstPage
+    uint16_t GetHeadPage() const;
+
+    /// Sequence number of the head page
+    uint16_t GetSequence() const;
+
+    /// Records in the head page
+    uint8_t GetHeadCount() const;
+
+    /// Timestamp of the newest record (0 if none), restored by Recover()
+    uint32_t GetLastTime() const;
+
+    /// Pages holding data, including the head page
+    uint16_t GetUsedPages() const;
+
+    /**
+     * @brief Read the records of one page in log order
+     * @param age 0 = oldest page, GetUsedPages() - 1 = head page
+     * @param out Room for GetRecordsPerPage() * GetRecordBytes() bytes
+     * @param count Number of records returned
+     */
+    bool ReadPage(uint16_t age, uint8_t* out, uint8_t& count);
+
+private:
+    EEPROM24FC256& m_eeprom;
+    uint8_t  m_recordBytes;
+    uint8_t  m_perPage;          ///< 0 if m_recordBytes is out of range
+    uint16_t m_firstPage;
+    uint16_t m_pageCount;
+
+    uint8_t  m_page[PAGE_SIZE];  ///< RAM image of the head page
+    uint16_t m_head;             ///< Head page, relative to m_firstPage
+    uint16_t m_seq;              ///< Sequence number of the head page
+    bool     m_wrapped;          ///< Pages after the head hold older data
+    bool     m_dirty;            ///< Head page image not yet written
+    uint32_t m_lastTime;         ///< Timestamp of the newest record
+
+    uint8_t HeaderCheck(uint16_t seq, uint8_t count) const;
+    uint16_t PageAddress(uint16_t page) const;
+    bool ReadHeader(uint16_t page, uint16_t& seq, bool& valid);
+    uint32_t RecordTime(const uint8_t* record) const;
+    void StartPage(uint16_t page, uint16_t seq);
+    void AdvancePage();
+};
+
+// Inline implementations
+
+inline SweepLog::SweepLog(EEPROM24FC256& eeprom, uint8_t recordBytes,
+                          uint16_t firstPage, uint16_t pageCount)
+    : m_eeprom(eeprom), m_recordBytes(recordBytes), m_perPage(0),
+      m_firstPage(firstPage), m_pageCount(pageCount),
+      m_page{}, m_head(0), m_seq(0), m_wrapped(false), m_dirty(false), m_lastTime(0) {
+    if (recordBytes >= TIME_BYTES && recordBytes <= PAGE_SIZE - HEADER_SIZE) {
+        m_perPage = static_cast<uint8_t>((PAGE_SIZE - HEADER_SIZE) / recordBytes);
+    }
+    StartPage(0, 0);
+}
+
+inline uint8_t SweepLog::HeaderCheck(uint16_t seq, uint8_t count) const {
+    return static_cast<uint8_t>((seq >> 8) ^ (seq & 0xFF) ^ count ^ m_recordBytes ^ 0xA5);
+}
+
+inline uint16_t SweepLog::PageAddress(uint16_t page) const {
+    return static_cast<uint16_t>((m_firstPage + page) * PAGE_SIZE);
+}
+
+inline uint32_t SweepLog::RecordTime(const uint8_t* record) const {
+    return (static_cast<uint32_t>(record[0]) << 24) | (static_cast<uint32_t>(record[1]) << 16) |
+           (static_cast<uint32_t>(record[2]) << 8) | record[3];
+}
+
+inline bool SweepLog::ReadHeader(uint16_t page, uint16_t& seq, bool& valid) {
+    uint8_t hdr[HEADER_SIZE];
+    if (!m_eeprom.ReadBytes(PageAddress(page), hdr, sizeof(hdr))) {
+        return false;
+    }
+
+    seq = static_cast<uint16_t>((static_cast<uint16_t>(hdr[0]) << 8) | hdr[1]);
+    valid = (hdr[4] == HeaderCheck(seq, hdr[2])) && (hdr[3] == m_recordBytes) &&
+            (hdr[2] <= m_perPage);
+    return true;
+}
+
+inline void SweepLog::StartPage(uint16_t page, uint16_t seq) {
+    for (uint8_t i = 0; i < PAGE_SIZE; i++) {
+        m_page[i] = 0xFF;
+    }
+    m_head = page;
+    m_seq = seq;
+    m_page[0] = static_cast<uint8_t>(seq >> 8);
+    m_page[1] = static_cast<uint8_t>(seq & 0xFF);
+    m_page[2] = 0;
+    m_page[3] = m_recordBytes;
+    m_page[4] = HeaderCheck(seq, 0);
+    m_dirty = false;
+}
+
+inline void SweepLog::AdvancePage() {
+    uint16_t next = static_cast<uint16_t>(m_head + 1);
+    if (next >= m_pageCount) {
+        next = 0;
+        m_wrapped = true;
+    }
+    StartPage(next, static_cast<uint16_t>(m_seq + 1));
+}
+
+inline bool SweepLog::Recover() {
+    uint16_t seq0 = 0;
+    bool valid = false;
+
+    if (!ReadHeader(0, seq0, valid)) {
+        return false;
+    }
+    if (!valid || m_perPage == 0) {
+        m_wrapped = false;
+        m_lastTime = 0;
+        StartPage(0, 0);  // Empty ring
+        return true;
+    }
+
+    // Last page p with seq(p) == seq(0) + p; holds for 0 and fails past the head
+    uint16_t lo = 0;
+    uint16_t hi = static_cast<uint16_t>(m_pageCount - 1);
+    while (lo < hi) {
+        uint16_t mid = static_cast<uint16_t>((lo + hi + 1) / 2);
+        uint16_t seq = 0;
+        if (!ReadHeader(mid, seq, valid)) {
+            return false;
+        }
+        if (valid && static_cast<uint16_t>(seq - seq0) == mid) {
+            lo = mid;
+        } else {
+            hi = static_cast<uint16_t>(mid - 1);
+        }
+    }
+
+    // Older data follows the head if the next page holds a valid header
+    m_wrapped = false;
+    if (lo + 1 < m_pageCount) {
+        uint16_t seq = 0;
+        if (!ReadHeader(static_cast<uint16_t>(lo + 1), seq, valid)) {
+            return false;
+        }
+        m_wrapped = valid;
+    }
+
+    // Reload the head page so new records continue where the log stopped
+    if (!m_eeprom.ReadBytes(PageAddress(lo), m_page, PAGE_SIZE)) {
+        return false;
+    }
+    m_head = lo;
+    m_seq = static_cast<uint16_t>(seq0 + lo);
+    m_dirty = false;
+
+    // New records must not be older than the newest one on the device
+    uint8_t count = m_page[2];
+    m_lastTime = (count > 0)
+        ? RecordTime(&m_page[HEADER_SIZE + (count - 1) * m_recordBytes])
+        : 0;
+
+    if (count >= m_perPage) {
+        AdvancePage();  // Head page is full - next record opens a new one
+    }
+    return true;
+}
+
+inline bool SweepLog::AppendRecord(const int16_t* words, uint8_t count) {
+    if (m_perPage == 0 || count * EEPROM24FC256::BYTES_PER_SAMPLE != m_recordBytes) {
+        return false;
+    }
+
+    uint32_t timestamp = (static_cast<uint32_t>(static_cast<uint16_t>(words[0])) << 16) |
+                         static_cast<uint16_t>(words[1]);
+    if (timestamp < m_lastTime) {
+        return false;
+    }
+
+    // Previous page write failed - retry it before staging more
+    if (m_page[2] >= m_perPage) {
+        if (!Flush()) {
+            return false;
+        }
+        AdvancePage();
+    }
+
+    uint8_t off = static_cast<uint8_t>(HEADER_SIZE + m_page[2] * m_recordBytes);
+    for (uint8_t i = 0; i < count; i++) {
+        m_page[off++] = static_cast<uint8_t>((words[i] >> 8) & 0xFF);
+        m_page[off++] = static_cast<uint8_t>(words[i] & 0xFF);
+    }
+    uint8_t records = static_cast<uint8_t>(m_page[2] + 1);
+    m_page[2] = records;
+    m_page[4] = HeaderCheck(m_seq, records);
+    m_dirty = true;
+    m_lastTime = timestamp;
+
+    if (records == m_perPage) {
+        if (!Flush()) {
+            return false;
+        }
+        AdvancePage();
+    }
+    return true;
+}
+
+inline bool SweepLog::Flush() {
+    if (!m_dirty) {
+        return true;
+    }
+
+    // Header and records are contiguous: one page write, one write cycle
+    uint8_t len = static_cast<uint8_t>(HEADER_SIZE + m_page[2] * m_recordBytes);
+    if (!m_eeprom.WritePage(PageAddress(m_head), m_page, len)) {
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+inline uint8_t SweepLog::GetRecordBytes() const {
+    return m_recordBytes;
+}
+
+inline uint8_t SweepLog::GetRecordsPerPage() const {
+    return m_perPage;
+}
+
+inline uint16_t SweepLog::GetHeadPage() const {
+    return m_head;
+}
+
+inline uint16_t SweepLog::GetSequence() const {
+    return m_seq;
+}
+
+inline uint8_t SweepLog::GetHeadCount() const {
+    return m_page[2];
+}
+
+inline uint32_t SweepLog::GetLastTime() const {
+    return m_lastTime;
+}
+
+inline uint16_t SweepLog::GetUsedPages() const {
+    return m_wrapped ? m_pageCount : static_cast<uint16_t>(m_head + 1);
+}
+
+inline bool SweepLog::ReadPage(uint16_t age, uint8_t* out, uint8_t& count) {
+    count = 0;
+    uint16_t used = GetUsedPages();
+    if (age >= used) {
+        return false;
+    }
+
+    // Head page comes from RAM (may hold unflushed records)
+    uint16_t page = static_cast<uint16_t>((m_head + 1 + m_pageCount - used + age) % m_pageCount);
+    const uint8_t* data = m_page;
+    uint8_t buf[PAGE_SIZE];
+    if (page != m_head) {
+        if (!m_eeprom.ReadBytes(PageAddress(page), buf, PAGE_SIZE)) {
+            return false;
+        }
+        if (buf[2] > m_perPage) {
+            return false;
+        }
+        data = buf;
+    }
+
+    count = data[2];
+    uint8_t len = static_cast<uint8_t>(count * m_recordBytes);
+    for (uint8_t i = 0; i < len; i++) {
+        out[i] = data[HEADER_SIZE + i];
+    }
+    return true;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file SysTickTimer.hpp
+ * @brief ITimer driven by the Cortex-M SysTick interrupt
+ *
+ * SysTick counts the core clock down from a reload value and raises its
+ * exception at zero. Init() programs it for TICK_HZ interrupts per
+ * second; SysTick_Handler (src/SysTickTimer.cpp) calls OnTick(), which
+ * counts ticks into whole seconds, so GetElapsedSeconds() is a plain
+ * 32-bit read (atomic on the M3) and wraps only after ~136 years.
+ *
+ * SleepUntil() executes WFI until a deadline: the core stops between
+ * ticks and the SysTick interrupt wakes it, so at a 10-minute interval
+ * the CPU only runs for the sample itself and ~20 cycles per tick.
+ * WFI uses plain sleep (SLEEPDEEP = 0): deep sleep would stop the core
+ * clock and SysTick with it.
+ *
+ * Under QEMU the same code runs unchanged; with -icount sleep=off the
+ * virtual clock skips ahead while the CPU is in WFI, so a full run does
+ * not take 16384 x 10 minutes of wall time.
+ *
+ * Only the interrupt-facing half (OnTick() and the counters) is in this
+ * header, so host tests can drive it without the hardware. On the host,
+ * src/SysTickTimer.cpp skips the registers and turns every WFI into one
+ * tick, so the sleep loops run against simulated time.
+ */
+
+#pragma once
+#include "ITimer.hpp"
+#include <cstdint>
+
+class SysTickTimer : public ITimer {
+public:
+    static constexpr uint32_t TICK_HZ = 100;          ///< 10 ms per tick
+    static constexpr uint32_t DEFAULT_CORE_HZ = 8000000;  ///< STM32F103 after reset (HSI)
+    static constexpr uint32_t MAX_RELOAD = 0x00FFFFFF;    ///< SysTick counter is 24 bits
+
+    /// Timer for a core clocked at coreHz
+    explicit SysTickTimer(uint32_t coreHz = DEFAULT_CORE_HZ);
+
+    /// Program SysTick for TICK_HZ interrupts and make this the active timer
+    void Init() override;
+
+    uint32_t GetElapsedSeconds() const override;
+
+    /// Ticks since Init() (wraps after ~497 days at 100 Hz)
+    uint32_t GetTicks() const;
+
+    /**
+     * @brief Sleep (WFI) until GetElapsedSeconds() reaches deadline
+     *
+     * Returns at once if the deadline has passed. Deadlines are compared
+     * with wrap-around (see Reached()), so they must lie within 68 years
+     * of now.
+     */
+    void SleepUntil(uint32_t deadline);
+
+    /// Sleep (WFI) for the given number of ticks (e.g. a retry backoff)
+    void SleepTicks(uint32_t ticks);
+
+    /// Called by SysTick_Handler once per tick (interrupt context)
+    void OnTick();
+
+    /// SysTick reload value for coreHz (counts coreHz / TICK_HZ cycles)
+    static constexpr uint32_t ReloadFor(uint32_t coreHz);
+
+    /// True once now has reached deadline, across a counter wrap
+    static constexpr bool Reached(uint32_t now, uint32_t deadline);
+
+private:
+    uint32_t m_coreHz;
+    volatile uint32_t m_seconds;
+    volatile uint32_t m_subTicks;  ///< Ticks into the current second
+    volatile uint32_t m_ticks;
+};
+
+// Inline implementations
+
+constexpr uint32_t SysTickTimer::ReloadFor(uint32_t coreHz) {
+    return coreHz / TICK_HZ - 1;
+}
+
+constexpr bool SysTickTimer::Reached(uint32_t now, uint32_t deadline) {
+    return static_cast<int32_t>(deadline - now) <= 0;
+}
+
+inline SysTickTimer::SysTickTimer(uint32_t coreHz)
+    : m_coreHz(coreHz), m_seconds(0), m_subTicks(0), m_ticks(0) {
+}
+
+inline uint32_t SysTickTimer::GetElapsedSeconds() const {
+    return m_seconds;
+}
+
+inline uint32_t SysTickTimer::GetTicks() const {
+    return m_ticks;
+}
+
+inline void SysTickTimer::OnTick() {
+    m_ticks = m_ticks + 1;
+    uint32_t sub = m_subTicks + 1;
+    if (sub == TICK_HZ) {
+        sub = 0;
+        m_seconds = m_seconds + 1;
+    }
+    m_subTicks = sub;
+}
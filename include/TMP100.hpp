@@ -4,14 +4,45 @@
  * 
  * Specs: -55 to +125 deg C, 12-bit (0.0625 deg C resolution), I2C interface
  * 
- * Uses: 12-bit continuous mode, register-based I2C interface
+ * Uses: 12-bit continuous mode by default, register-based I2C interface
+ * 
+ * One-shot mode: the sensor stays in shutdown (~0.1 uA typ) and converts
+ * only when StartConversion() sets OS. The driver knows the datasheet
+ * maximum conversion time for the configured resolution, so the caller
+ * can start a conversion, do other work (or sleep) for
+ * GetConversionTimeMs(), then read the result without polling the bus.
+ * 
+ * Resolution trades precision for latency (datasheet max conversion):
+ *   bits  LSB        conversion   max rate
+ *   9     0.5 C      75 ms        13 /s
+ *   10    0.25 C     150 ms       6 /s
+ *   11    0.125 C    300 ms       3 /s
+ *   12    0.0625 C   600 ms       1.6 /s
+ * BeginBurst()/EndBurst() switch to 9-bit continuous conversion for
+ * fast capture of transients and restore the previous configuration.
+ * 
+ * Thermostat: SetThresholds() programs TLOW/THIGH and ConfigureAlert()
+ * selects comparator or interrupt mode and the fault queue, so the
+ * sensor compares every conversion against the band in hardware. The
+ * TMP100 has no ALERT pin (unlike the TMP101); the thermostat output is
+ * read back as the OS/ALERT bit of the configuration register, a one
+ * byte read, with ReadAlert().
+ * 
+ * Pointer register: the driver tracks which register the sensor's
+ * pointer selects (next to the cached configuration). A read of the
+ * register already selected is a bare Read - one transaction instead of
+ * a pointer write plus read - so back-to-back temperature reads cost a
+ * single transaction each. Writes move the pointer to the written
+ * register; a failed transaction leaves it unknown.
  */
 
 #pragma once
 #include "II2CController.hpp"
+#include "Temperature.hpp"
 #include <cstdint>
 
-class TMP100 {
+/// Register-level settings shared by every TMP100T<Bus> instantiation
+class TMP100Base {
 public:
     enum class Resolution : uint8_t {
         Bits_9  = 0x00,  
@@ -20,14 +51,156 @@ public:
         Bits_12 = 0x60   // Used in this driver
     };
     
+    enum class ConversionMode : uint8_t {
+        Continuous,  ///< Converts back to back (SD = 0)
+        OneShot      ///< Shut down between StartConversion() calls (SD = 1)
+    };
+    
+    enum class AlertMode : uint8_t {
+        Comparator = 0x00,  ///< Active from THIGH until back below TLOW (TM = 0)
+        Interrupt  = 0x02   ///< Latched on each crossing, cleared by any read (TM = 1)
+    };
+    
+    /// Consecutive out-of-band conversions before the alert changes (F1:F0)
+    enum class FaultQueue : uint8_t {
+        Faults_1 = 0x00,
+        Faults_2 = 0x08,
+        Faults_4 = 0x10,
+        Faults_6 = 0x18
+    };
+};
+
+/**
+ * @brief TMP100 driver over bus type Bus
+ * 
+ * Bus is II2CController for the virtual adapter (alias TMP100), or a
+ * concrete final controller so every transaction binds statically.
+ */
+template <typename Bus>
+class TMP100T : public TMP100Base {
+public:
     /// Constructor takes I2C controller and device address
-    TMP100(II2CController& i2c, uint8_t address);
+    TMP100T(Bus& i2c, uint8_t address);
+    
+    /// Initialize sensor (default: 12-bit continuous mode)
+    bool Init(ConversionMode mode = ConversionMode::Continuous,
+              Resolution res = Resolution::Bits_12);
+    
+    /**
+     * @brief Trigger a single conversion (one-shot mode)
+     * 
+     * Writes the configuration with OS = 1; the sensor converts once and
+     * returns to shutdown. The result is valid after GetConversionTimeMs().
+     * In continuous mode there is nothing to trigger and this returns true
+     * without touching the bus.
+     * 
+     * @return false on I2C error
+     */
+    bool StartConversion();
+    
+    /// Datasheet maximum conversion time for the configured resolution:
+    /// 75 / 150 / 300 / 600 ms for 9 / 10 / 11 / 12 bits
+    uint16_t GetConversionTimeMs() const;
+    
+    /// Mode selected by Init()
+    ConversionMode GetConversionMode() const;
+    
+    /**
+     * @brief Change resolution at runtime, keeping the conversion mode
+     * 
+     * In continuous mode the temperature register keeps the previous
+     * result until a conversion at the new resolution has completed
+     * (GetConversionTimeMs() later). No bus traffic if unchanged.
+     * 
+     * @return false on I2C error (cached configuration unchanged)
+     */
+    bool SetResolution(Resolution res);
+    
+    /// Resolution currently configured
+    Resolution GetResolution() const;
+    
+    /// Size of one LSB in Q12.4 units (1/16 C): 8 / 4 / 2 / 1 for 9..12 bits
+    uint8_t GetLsbQ4() const;
+    
+    /**
+     * @brief Burst-capture profile: 9-bit continuous conversion
+     * 
+     * Saves the current configuration and switches to the fastest
+     * setting (75 ms per conversion, ~8x the 12-bit sample rate).
+     * Calling it again while a burst is active changes nothing.
+     * 
+     * @return false on I2C error
+     */
+    bool BeginBurst();
+    
+    /// Restore the configuration saved by BeginBurst()
+    bool EndBurst();
+    
+    /// True between BeginBurst() and EndBurst()
+    bool IsBursting() const;
+    
+    /**
+     * @brief Program the thermostat band (Q12.4, 1/16 C)
+     * 
+     * Values are written left-justified like the temperature register;
+     * bits below 12-bit precision are ignored by the sensor.
+     * 
+     * @return false on I2C error or if low > high
+     */
+    bool SetThresholds(int16_t lowQ4, int16_t highQ4);
+    
+    /// Program the thermostat band
+    bool SetThresholds(Temperature low, Temperature high);
     
-    /// Initialize sensor to 12-bit continuous mode
-    bool Init();
+#ifndef TEMPLOGGER_NO_FLOAT
+    /// Program the thermostat band in degrees C (host-side)
+    bool SetThresholds(float low, float high);
+#endif
     
-    /// Read temperature (returns -999.0f on I2C error)
+    /**
+     * @brief Select thermostat mode and fault queue (call after Init())
+     * 
+     * Keeps resolution and conversion mode. The comparator only runs on
+     * conversions, so in one-shot mode it is updated once per trigger.
+     * 
+     * @return false on I2C error
+     */
+    bool ConfigureAlert(AlertMode mode, FaultQueue faults = FaultQueue::Faults_1);
+    
+    /**
+     * @brief Read the thermostat output (OS/ALERT bit, POL applied)
+     * 
+     * Comparator mode: true while the temperature is out of band
+     * (hysteresis TLOW..THIGH). Interrupt mode: true if a threshold was
+     * crossed since the last register read; reading clears it.
+     * 
+     * @return false on I2C error
+     */
+    bool ReadAlert(bool& active);
+    
+#ifndef TEMPLOGGER_NO_FLOAT
+    /// Read temperature (returns -999.0f on I2C error; host-side)
     float ReadTemperature();
+#endif
+    
+    /// Read temperature as Q12.4 (1/16 C); false on I2C error
+    bool ReadTemperature(int16_t& encoded);
+    
+    /// Read temperature; false on I2C error (temp is left unchanged)
+    bool ReadTemperature(Temperature& temp);
+    
+    /**
+     * @brief Describe a temperature read for a batched Transfer()
+     * 
+     * Same bus traffic as ReadTemperature(): a bare read when the pointer
+     * already selects the temperature register, else pointer write + read.
+     * 
+     * @param rx 2-byte buffer the transaction reads into
+     */
+    void PrepareTemperatureRead(I2CTransaction& t, uint8_t* rx) const;
+    
+    /// Decode a read prepared above once the bus has run it; false if it failed
+    bool FinishTemperatureRead(const I2CTransaction& t, int16_t& encoded);
 
 private:
     static constexpr uint8_t REG_TEMPERATURE = 0x00;
@@ -36,64 +209,290 @@ private:
     static constexpr uint8_t REG_THIGH       = 0x03;
     
     static constexpr uint8_t CFG_SHUTDOWN    = 0x01;
+    static constexpr uint8_t CFG_THERMOSTAT  = 0x02;
+    static constexpr uint8_t CFG_POLARITY    = 0x04;
+    static constexpr uint8_t CFG_FAULTS      = 0x18;
     static constexpr uint8_t CFG_ONESHOT     = 0x80;
     static constexpr uint8_t CFG_RESOLUTION  = 0x60;
     
-    II2CController& m_i2c;
+    static constexpr uint16_t CONVERSION_MS_9BIT = 75;  ///< Max, doubles per bit
+    static constexpr uint8_t  POINTER_UNKNOWN = 0xFF;
+    
+    Bus& m_i2c;
     uint8_t m_address;
     uint8_t m_configCache;
+    uint8_t m_pointer;      ///< Register selected by the pointer (or POINTER_UNKNOWN)
+    uint8_t m_savedConfig;  ///< Configuration to restore after a burst
+    bool m_bursting;
     
     bool WriteConfig(uint8_t value);
+    bool WriteLimit(uint8_t reg, int16_t valueQ4);
+    
+    /// Write a register (pointer + data); tracks the pointer
+    bool WriteRegister(const uint8_t* tx, size_t len);
+    
+    /// Read a register, skipping the pointer write when already selected
+    bool ReadRegister(uint8_t reg, uint8_t* rx, size_t len);
+    
+    /// Temperature register bytes to Q12.4
+    static int16_t DecodeTemperature(const uint8_t* rx);
 };
 
+/// TMP100 over the virtual II2CController interface
+using TMP100 = TMP100T<II2CController>;
+
 // Implementation: inline functions
 
-inline TMP100::TMP100(II2CController& i2c, uint8_t address)
-    : m_i2c(i2c), m_address(address), m_configCache(0) {
+template <typename Bus>
+inline TMP100T<Bus>::TMP100T(Bus& i2c, uint8_t address)
+    : m_i2c(i2c), m_address(address), m_configCache(0), m_pointer(POINTER_UNKNOWN),
+      m_savedConfig(0), m_bursting(false) {
 }
 
-inline bool TMP100::Init() {
-    // Config = 0x60: 12-bit mode, continuous conversion
-    const uint8_t config = static_cast<uint8_t>(Resolution::Bits_12);
+template <typename Bus>
+inline bool TMP100T<Bus>::Init(ConversionMode mode, Resolution res) {
+    // Default config = 0x60: 12-bit mode, continuous conversion
+    uint8_t config = static_cast<uint8_t>(res);
+    if (mode == ConversionMode::OneShot) {
+        config |= CFG_SHUTDOWN;
+    }
 
     /*
     Bit	Value	Meaning
-    SD	0	continuous mode
+    SD	0/1	continuous mode / shutdown (one-shot)
     TM	0	comparator
     POL	0	active low
     Fault	0	1 fault
-    R1:R0	11	12-bit
-    OS	0	ignored
+    R1:R0	xx	resolution (11 = 12-bit)
+    OS	0	set by StartConversion() in one-shot mode
     */
     return WriteConfig(config);
 }
 
-inline bool TMP100::WriteConfig(uint8_t value) {
+template <typename Bus>
+inline bool TMP100T<Bus>::StartConversion() {
+    if ((m_configCache & CFG_SHUTDOWN) == 0) {
+        return true;  // Continuous mode: always converting
+    }
+
+    // OS is self-clearing: keep it out of the cached configuration
+    uint8_t tx[2] = { REG_CONFIG, static_cast<uint8_t>(m_configCache | CFG_ONESHOT) };
+    return WriteRegister(tx, sizeof(tx));
+}
+
+template <typename Bus>
+inline uint16_t TMP100T<Bus>::GetConversionTimeMs() const {
+    uint8_t bits = static_cast<uint8_t>((m_configCache & CFG_RESOLUTION) >> 5);
+    return static_cast<uint16_t>(CONVERSION_MS_9BIT << bits);
+}
+
+template <typename Bus>
+inline TMP100Base::ConversionMode TMP100T<Bus>::GetConversionMode() const {
+    return (m_configCache & CFG_SHUTDOWN) ? ConversionMode::OneShot : ConversionMode::Continuous;
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::SetResolution(Resolution res) {
+    uint8_t config = static_cast<uint8_t>((m_configCache & ~CFG_RESOLUTION) | static_cast<uint8_t>(res));
+    if (config == m_configCache) {
+        return true;
+    }
+    return WriteConfig(config);
+}
+
+template <typename Bus>
+inline TMP100Base::Resolution TMP100T<Bus>::GetResolution() const {
+    return static_cast<Resolution>(m_configCache & CFG_RESOLUTION);
+}
+
+template <typename Bus>
+inline uint8_t TMP100T<Bus>::GetLsbQ4() const {
+    uint8_t bits = static_cast<uint8_t>((m_configCache & CFG_RESOLUTION) >> 5);
+    return static_cast<uint8_t>(8 >> bits);
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::BeginBurst() {
+    if (m_bursting) {
+        return true;
+    }
+
+    uint8_t saved = m_configCache;
+    // 9-bit, continuous (SD = 0): a new result every 75 ms without triggers
+    uint8_t config = static_cast<uint8_t>(m_configCache & ~(CFG_RESOLUTION | CFG_SHUTDOWN));
+    if (!WriteConfig(config)) {
+        return false;
+    }
+    m_savedConfig = saved;
+    m_bursting = true;
+    return true;
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::EndBurst() {
+    if (!m_bursting) {
+        return true;
+    }
+    if (!WriteConfig(m_savedConfig)) {
+        return false;
+    }
+    m_bursting = false;
+    return true;
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::IsBursting() const {
+    return m_bursting;
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::WriteLimit(uint8_t reg, int16_t valueQ4) {
+    // Same left-justified format as the temperature register
+    uint16_t raw = static_cast<uint16_t>(static_cast<uint16_t>(valueQ4) << 4);
+    uint8_t tx[3] = { reg, static_cast<uint8_t>(raw >> 8), static_cast<uint8_t>(raw & 0xFF) };
+    return WriteRegister(tx, sizeof(tx));
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::SetThresholds(int16_t lowQ4, int16_t highQ4) {
+    if (lowQ4 > highQ4) {
+        return false;
+    }
+    return WriteLimit(REG_TLOW, lowQ4) && WriteLimit(REG_THIGH, highQ4);
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::SetThresholds(Temperature low, Temperature high) {
+    return SetThresholds(low.Raw(), high.Raw());
+}
+
+#ifndef TEMPLOGGER_NO_FLOAT
+template <typename Bus>
+inline bool TMP100T<Bus>::SetThresholds(float low, float high) {
+    return SetThresholds(Temperature::FromFloat(low), Temperature::FromFloat(high));
+}
+#endif
+
+template <typename Bus>
+inline bool TMP100T<Bus>::ConfigureAlert(AlertMode mode, FaultQueue faults) {
+    uint8_t config = static_cast<uint8_t>(m_configCache & ~(CFG_THERMOSTAT | CFG_POLARITY | CFG_FAULTS));
+    config |= static_cast<uint8_t>(mode);
+    config |= static_cast<uint8_t>(faults);
+    return WriteConfig(config);
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::ReadAlert(bool& active) {
+    uint8_t config = 0;
+    if (!ReadRegister(REG_CONFIG, &config, 1)) {
+        return false;
+    }
+    
+    // POL = 0: OS/ALERT reads 0 while active; POL = 1 inverts it
+    bool bit = (config & CFG_ONESHOT) != 0;
+    bool pol = (m_configCache & CFG_POLARITY) != 0;
+    active = (bit == pol);
+    return true;
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::WriteConfig(uint8_t value) {
     uint8_t tx[2] = { REG_CONFIG, value };
     
-    if (m_i2c.Write(m_address, tx, sizeof(tx)) == I2CStatus::OK) {
+    if (WriteRegister(tx, sizeof(tx))) {
         m_configCache = value;
         return true;
     }
     return false;
 }
 
-inline float TMP100::ReadTemperature() {
-    uint8_t regAddr = REG_TEMPERATURE;
-    uint8_t rawData[2] = {0, 0};
-    
-    I2CStatus status = m_i2c.WriteRead(m_address, &regAddr, 1, rawData, 2);
+template <typename Bus>
+inline bool TMP100T<Bus>::WriteRegister(const uint8_t* tx, size_t len) {
+    if (m_i2c.Write(m_address, tx, len) != I2CStatus::OK) {
+        m_pointer = POINTER_UNKNOWN;  // May or may not have been latched
+        return false;
+    }
+    m_pointer = tx[0];
+    return true;
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::ReadRegister(uint8_t reg, uint8_t* rx, size_t len) {
+    I2CStatus status = (m_pointer == reg)
+        ? m_i2c.Read(m_address, rx, len)
+        : m_i2c.WriteRead(m_address, &reg, 1, rx, len);
     
     if (status != I2CStatus::OK) {
+        m_pointer = POINTER_UNKNOWN;
+        return false;
+    }
+    m_pointer = reg;
+    return true;
+}
+
+#ifndef TEMPLOGGER_NO_FLOAT
+template <typename Bus>
+inline float TMP100T<Bus>::ReadTemperature() {
+    Temperature temp;
+    if (!ReadTemperature(temp)) {
         return -999.0f;  // Error sentinel (outside valid range)
     }
+    return temp.ToFloat();
+}
+#endif
+
+template <typename Bus>
+inline bool TMP100T<Bus>::ReadTemperature(Temperature& temp) {
+    int16_t rawTemp = 0;
+    if (!ReadTemperature(rawTemp)) {
+        return false;
+    }
+    temp = Temperature::FromRaw(rawTemp);
+    return true;
+}
+
+template <typename Bus>
+inline bool TMP100T<Bus>::ReadTemperature(int16_t& encoded) {
+    uint8_t rawData[2] = {0, 0};
     
+    // Bare read when the pointer already selects the temperature register
+    if (!ReadRegister(REG_TEMPERATURE, rawData, sizeof(rawData))) {
+        return false;
+    }
+    
+    encoded = DecodeTemperature(rawData);
+    return true;
+}
+
+template <typename Bus>
+inline int16_t TMP100T<Bus>::DecodeTemperature(const uint8_t* rx) {
     // Combine bytes (big-endian), shift to get 12-bit value
-    int16_t rawTemp = static_cast<int16_t>((rawData[0] << 8) | rawData[1]);
+    int16_t rawTemp = static_cast<int16_t>((rx[0] << 8) | rx[1]);
+    return static_cast<int16_t>(rawTemp >> 4);
+}
 
-    rawTemp >>= 4;
+template <typename Bus>
+inline void TMP100T<Bus>::PrepareTemperatureRead(I2CTransaction& t, uint8_t* rx) const {
+    static const uint8_t POINTER = REG_TEMPERATURE;
+    bool selected = (m_pointer == REG_TEMPERATURE);
     
-    // Convert to Celsius (LSB = 0.0625 deg C)
-    return static_cast<float>(rawTemp) * (1.0f / 16.0f);
+    t.addr = m_address;
+    t.header = selected ? nullptr : &POINTER;
+    t.headerLen = selected ? 0 : 1;
+    t.data = nullptr;
+    t.dataLen = 0;
+    t.rx = rx;
+    t.rxLen = 2;
+    t.status = I2CStatus::Error;
+}
 
+template <typename Bus>
+inline bool TMP100T<Bus>::FinishTemperatureRead(const I2CTransaction& t, int16_t& encoded) {
+    if (t.status != I2CStatus::OK) {
+        m_pointer = POINTER_UNKNOWN;
+        return false;
+    }
+    m_pointer = REG_TEMPERATURE;
+    encoded = DecodeTemperature(t.rx);
+    return true;
 }
@@ -0,0 +1,215 @@
+/**
+ * @file TMP100Array.hpp
+ * @brief Up to eight TMP100 sensors on one bus, sampled in one sweep
+ *
+ * The TMP100 address pins (ADD0/ADD1) give eight addresses, 0x48-0x4F.
+ * TMP100Array<N> owns the sensors at 0x48 .. 0x48+N-1 and samples them
+ * together:
+ *
+ *   TriggerAll()   one-shot mode: start every conversion back to back,
+ *                  so all N finish within one conversion time
+ *   Sweep()        read every present sensor once
+ *
+ * Bus cost per sweep: each sensor's pointer register stays on the
+ * temperature register between sweeps (see TMP100 pointer caching), so in
+ * continuous mode a sweep is exactly N bare 2-byte reads. In one-shot
+ * mode the trigger moves the pointer to the config register and each
+ * read is a pointer write + read. Sensors that failed Init() are skipped
+ * instead of being retried every sweep. The reads of one sweep go to the
+ * bus as a single II2CController::Transfer() batch.
+ *
+ * Bus selects the controller type like TMP100T<Bus>: the default goes
+ * through the virtual II2CController, a concrete final bus binds
+ * statically.
+ *
+ * A sweep is logged as one multi-channel record, either through an
+ * EEPROMPageWriter (records may span pages; the writer splits them, and
+ * a failed page write drops the whole record, never part of it) or
+ * through a SweepLog, whose write position survives resets:
+ *   word 0..1  timestamp (seconds), high word first
+ *   word 2     valid-channel mask (bit i = sensor i read OK)
+ *   word 3..   N samples, Q12.4 (INVALID for failed channels)
+ */
+
+#pragma once
+#include "TMP100.hpp"
+#include "EEPROMPageWriter.hpp"
+#include "SweepLog.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+template <uint8_t N, typename Bus = II2CController>
+class TMP100Array {
+    static_assert(N >= 1 && N <= 8, "TMP100 address pins allow 1..8 sensors");
+
+public:
+    static constexpr uint8_t  BASE_ADDRESS = 0x48;
+    static constexpr uint8_t  CHANNELS     = N;
+    static constexpr uint8_t  RECORD_WORDS = 3 + N;
+    static constexpr uint16_t RECORD_BYTES = RECORD_WORDS * EEPROM24FC256::BYTES_PER_SAMPLE;
+    static constexpr int16_t  INVALID      = INT16_MIN;  ///< Sample of a failed channel
+
+    static_assert(RECORD_BYTES <= SweepLog::PAGE_SIZE - SweepLog::HEADER_SIZE,
+                  "A record fits one EEPROMPageWriter or SweepLog page");
+
+    /// Sensors at BASE_ADDRESS + 0 .. N-1 on one bus
+    explicit TMP100Array(Bus& i2c);
+
+    /**
+     * @brief Configure every sensor
+     *
+     * Sensors that do not acknowledge are marked absent and skipped by
+     * TriggerAll() and Sweep() until the next Init().
+     *
+     * @return true if every sensor was configured
+     */
+    bool Init(TMP100Base::ConversionMode mode = TMP100Base::ConversionMode::OneShot,
+              TMP100Base::Resolution res = TMP100Base::Resolution::Bits_12);
+
+    /// Start a conversion on every present sensor (no-op in continuous mode)
+    bool TriggerAll();
+
+    /// Time from TriggerAll() until every result is valid
+    uint16_t GetConversionTimeMs() const;
+
+    /**
+     * @brief Read every present sensor once
+     * @param values Room for N samples, Q12.4 (INVALID where a read failed)
+     * @return Mask of channels read successfully
+     */
+    uint8_t Sweep(int16_t* values);
+
+    /// Mask of sensors that acknowledged Init()
+    uint8_t GetPresentMask() const;
+
+    /// Direct access to one sensor (thresholds, alerts, resolution)
+    TMP100T<Bus>& operator[](uint8_t index);
+
+    /// Stage one sweep as a multi-channel record in an EEPROMPageWriter
+    /// or a SweepLog (RECORD_BYTES records)
+    /// Returns false if the log rejected the record or a page write failed
+    /// (see EEPROMPageWriter::AppendRecord, SweepLog::AppendRecord)
+    template <typename Log>
+    static bool LogSweep(Log& log, uint32_t timestamp,
+                         const int16_t* values, uint8_t mask);
+
+    /// Decode a record read back from EEPROM (RECORD_BYTES bytes)
+    static void DecodeRecord(const uint8_t* raw, uint32_t& timestamp,
+                             int16_t* values, uint8_t& mask);
+
+private:
+    Bus&    m_i2c;
+    TMP100T<Bus> m_sensors[N];
+    uint8_t m_present;  ///< Bit i set if sensor i acknowledged Init()
+
+    template <size_t... I>
+    TMP100Array(Bus& i2c, std::index_sequence<I...>);
+};
+
+// Inline implementations
+
+template <uint8_t N, typename Bus>
+template <size_t... I>
+inline TMP100Array<N, Bus>::TMP100Array(Bus& i2c, std::index_sequence<I...>)
+    : m_i2c(i2c), m_sensors{ TMP100T<Bus>(i2c, static_cast<uint8_t>(BASE_ADDRESS + I))... }, m_present(0) {
+}
+
+template <uint8_t N, typename Bus>
+inline TMP100Array<N, Bus>::TMP100Array(Bus& i2c)
+    : TMP100Array(i2c, std::make_index_sequence<N>()) {
+}
+
+template <uint8_t N, typename Bus>
+inline bool TMP100Array<N, Bus>::Init(TMP100Base::ConversionMode mode, TMP100Base::Resolution res) {
+    m_present = 0;
+    for (uint8_t i = 0; i < N; i++) {
+        if (m_sensors[i].Init(mode, res)) {
+            m_present = static_cast<uint8_t>(m_present | (1u << i));
+        }
+    }
+    return m_present == static_cast<uint8_t>((1u << N) - 1);
+}
+
+template <uint8_t N, typename Bus>
+inline bool TMP100Array<N, Bus>::TriggerAll() {
+    bool ok = true;
+    for (uint8_t i = 0; i < N; i++) {
+        if (m_present & (1u << i)) {
+            ok = m_sensors[i].StartConversion() && ok;
+        }
+    }
+    return ok;
+}
+
+template <uint8_t N, typename Bus>
+inline uint16_t TMP100Array<N, Bus>::GetConversionTimeMs() const {
+    // Same resolution everywhere; triggers are microseconds apart
+    return m_sensors[0].GetConversionTimeMs();
+}
+
+template <uint8_t N, typename Bus>
+inline uint8_t TMP100Array<N, Bus>::Sweep(int16_t* values) {
+    // One batch for all present sensors
+    I2CTransaction batch[N];
+    uint8_t rx[N][2];
+    uint8_t channel[N];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < N; i++) {
+        values[i] = INVALID;  // Left untouched by a failed read
+        if (m_present & (1u << i)) {
+            m_sensors[i].PrepareTemperatureRead(batch[count], rx[count]);
+            channel[count++] = i;
+        }
+    }
+    if (count == 0) {
+        return 0;
+    }
+    
+    m_i2c.Transfer(batch, count);
+    
+    uint8_t mask = 0;
+    for (uint8_t k = 0; k < count; k++) {
+        uint8_t i = channel[k];
+        if (m_sensors[i].FinishTemperatureRead(batch[k], values[i])) {
+            mask = static_cast<uint8_t>(mask | (1u << i));
+        }
+    }
+    return mask;
+}
+
+template <uint8_t N, typename Bus>
+inline uint8_t TMP100Array<N, Bus>::GetPresentMask() const {
+    return m_present;
+}
+
+template <uint8_t N, typename Bus>
+inline TMP100T<Bus>& TMP100Array<N, Bus>::operator[](uint8_t index) {
+    return m_sensors[index];
+}
+
+template <uint8_t N, typename Bus>
+template <typename Log>
+inline bool TMP100Array<N, Bus>::LogSweep(Log& log, uint32_t timestamp,
+                                          const int16_t* values, uint8_t mask) {
+    int16_t record[RECORD_WORDS];
+    record[0] = static_cast<int16_t>(timestamp >> 16);
+    record[1] = static_cast<int16_t>(timestamp & 0xFFFF);
+    record[2] = static_cast<int16_t>(mask);
+    for (uint8_t i = 0; i < N; i++) {
+        record[3 + i] = values[i];
+    }
+    return log.AppendRecord(record, RECORD_WORDS);
+}
+
+template <uint8_t N, typename Bus>
+inline void TMP100Array<N, Bus>::DecodeRecord(const uint8_t* raw, uint32_t& timestamp,
+                                         int16_t* values, uint8_t& mask) {
+    timestamp = (static_cast<uint32_t>(raw[0]) << 24) | (static_cast<uint32_t>(raw[1]) << 16) |
+                (static_cast<uint32_t>(raw[2]) << 8) | raw[3];
+    mask = raw[5];
+    for (uint8_t i = 0; i < N; i++) {
+        const uint8_t* v = &raw[6 + i * 2];
+        values[i] = static_cast<int16_t>((static_cast<uint16_t>(v[0]) << 8) | v[1]);
+    }
+}
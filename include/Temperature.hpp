@@ -0,0 +1,115 @@
+/**
+ * @file Temperature.hpp
+ * @brief Fixed-point temperature value (Q12.4, 1/16 deg C)
+ *
+ * The Cortex-M3 has no FPU, so every float multiply or convert is a
+ * soft-float library call. Temperature keeps the sensor's own format from
+ * the register read to the EEPROM: the TMP100 reports 1/16 C steps and
+ * the log stores them as int16_t, so no conversion is needed in between.
+ *
+ * Range: -2048.0 .. +2047.9375 C (the TMP100 covers -55 .. +125 C).
+ *
+ * Float conversions exist only for host-side tools and tests. The
+ * firmware build defines TEMPLOGGER_NO_FLOAT, which removes them and
+ * every float overload in the drivers, so a float in the data path is a
+ * compile error rather than a silent soft-float call.
+ */
+
+#pragma once
+#include <cstdint>
+
+class Temperature {
+public:
+    static constexpr int16_t STEPS_PER_DEGREE = 16;  ///< LSB = 0.0625 C
+
+    /// 0.0 C
+    constexpr Temperature() : m_raw(0) {}
+
+    /// From the Q12.4 encoding used by the TMP100 driver and the logs
+    static constexpr Temperature FromRaw(int16_t q4);
+
+    /// From whole degrees C
+    static constexpr Temperature FromDegrees(int16_t degrees);
+
+    /// From hundredths of a degree C, rounded to the nearest 1/16 C
+    static constexpr Temperature FromCentiDegrees(int32_t centi);
+
+    /// Q12.4 encoding (what the EEPROM stores)
+    constexpr int16_t Raw() const;
+
+    /// Whole degrees C, truncated toward zero
+    constexpr int16_t WholeDegrees() const;
+
+    /// Hundredths of a degree C, rounded (for display: 2150 = 21.50 C)
+    constexpr int32_t CentiDegrees() const;
+
+    constexpr bool operator==(Temperature other) const { return m_raw == other.m_raw; }
+    constexpr bool operator!=(Temperature other) const { return m_raw != other.m_raw; }
+    constexpr bool operator<(Temperature other) const  { return m_raw < other.m_raw; }
+    constexpr bool operator<=(Temperature other) const { return m_raw <= other.m_raw; }
+    constexpr bool operator>(Temperature other) const  { return m_raw > other.m_raw; }
+    constexpr bool operator>=(Temperature other) const { return m_raw >= other.m_raw; }
+
+    constexpr Temperature operator+(Temperature other) const;
+    constexpr Temperature operator-(Temperature other) const;
+
+#ifndef TEMPLOGGER_NO_FLOAT
+    /// Host-side only: degrees C, truncated toward zero like the old encoder
+    static Temperature FromFloat(float degrees);
+
+    /// Host-side only: degrees C
+    float ToFloat() const;
+#endif
+
+private:
+    explicit constexpr Temperature(int16_t raw) : m_raw(raw) {}
+
+    int16_t m_raw;  ///< Q12.4
+};
+
+// Inline implementations
+
+constexpr Temperature Temperature::FromRaw(int16_t q4) {
+    return Temperature(q4);
+}
+
+constexpr Temperature Temperature::FromDegrees(int16_t degrees) {
+    return Temperature(static_cast<int16_t>(degrees * STEPS_PER_DEGREE));
+}
+
+constexpr Temperature Temperature::FromCentiDegrees(int32_t centi) {
+    // q4 = centi * 16 / 100 = centi * 4 / 25, rounded half away from zero
+    return Temperature(static_cast<int16_t>(
+        (centi * 4 + (centi >= 0 ? 12 : -12)) / 25));
+}
+
+constexpr int16_t Temperature::Raw() const {
+    return m_raw;
+}
+
+constexpr int16_t Temperature::WholeDegrees() const {
+    return static_cast<int16_t>(m_raw / STEPS_PER_DEGREE);
+}
+
+constexpr int32_t Temperature::CentiDegrees() const {
+    // centi = q4 * 100 / 16 = q4 * 25 / 4, rounded half away from zero
+    return (static_cast<int32_t>(m_raw) * 25 + (m_raw >= 0 ? 2 : -2)) / 4;
+}
+
+constexpr Temperature Temperature::operator+(Temperature other) const {
+    return Temperature(static_cast<int16_t>(m_raw + other.m_raw));
+}
+
+constexpr Temperature Temperature::operator-(Temperature other) const {
+    return Temperature(static_cast<int16_t>(m_raw - other.m_raw));
+}
+
+#ifndef TEMPLOGGER_NO_FLOAT
+inline Temperature Temperature::FromFloat(float degrees) {
+    return Temperature(static_cast<int16_t>(degrees * 16.0f));
+}
+
+inline float Temperature::ToFloat() const {
+    return static_cast<float>(m_raw) * (1.0f / 16.0f);
+}
+#endif
@@ -0,0 +1,273 @@
+/**
+ * @file TemperatureFilter.hpp
+ * @brief Fixed-point smoothing between the sensor and the log
+ *
+ * A single TMP100 reading near an HVAC vent can be a draft, not the room.
+ * These filters clean up readings in Q12.4 with compile-time-sized ring
+ * buffers (no allocation, no floats):
+ *
+ *   MedianFilter<N>     median of the last N readings; rejects spikes
+ *                       shorter than N/2 samples outright
+ *   MovingAverage<N>    rounded mean of the last N readings (int32 sum)
+ *   IIRFilter<Shift>    y += (x - y) / 2^Shift, Shift fraction bits of
+ *                       extra state so small steps are not lost to rounding
+ *
+ * All filters share one shape: Push() takes a reading and returns the
+ * current output, Reset() forgets history. FilterChain<A, B> feeds A's
+ * output into B (e.g. median to drop spikes, then average).
+ *
+ * Oversampler<Filter> collapses a burst of readings into the one value
+ * that is logged: readings taken between log deadlines are pushed into
+ * the filter, Collapse() returns its output and starts the next burst.
+ * The EEPROM still holds one sample per interval.
+ */
+
+#pragma once
+#include "Temperature.hpp"
+#include <cstdint>
+
+template <uint8_t N>
+class MedianFilter {
+    static_assert(N >= 1 && N <= 32, "Median window is sorted on every push");
+
+public:
+    MedianFilter();
+
+    /// Add a reading; returns the median of the readings held (up to N)
+    Temperature Push(Temperature reading);
+
+    /// Forget all readings
+    void Reset();
+
+    /// Readings held (N once the window is full)
+    uint8_t GetCount() const;
+
+private:
+    int16_t m_window[N];  ///< Ring of Q12.4 readings
+    uint8_t m_next;
+    uint8_t m_count;
+};
+
+template <uint8_t N>
+class MovingAverage {
+    static_assert(N >= 1, "Window must hold at least one reading");
+
+public:
+    MovingAverage();
+
+    /// Add a reading; returns the rounded mean of the readings held (up to N)
+    Temperature Push(Temperature reading);
+
+    void Reset();
+
+    uint8_t GetCount() const;
+
+private:
+    int16_t m_window[N];
+    int32_t m_sum;  ///< Sum of the readings held, Q12.4
+    uint8_t m_next;
+    uint8_t m_count;
+};
+
+template <uint8_t Shift>
+class IIRFilter {
+    static_assert(Shift >= 1 && Shift <= 8, "Shift 1..8 (alpha 1/2 .. 1/256)");
+
+public:
+    IIRFilter();
+
+    /// Add a reading; the first reading after Reset() initializes the output
+    Temperature Push(Temperature reading);
+
+    void Reset();
+
+private:
+    int32_t m_state;  ///< Output, Q12.4 with Shift extra fraction bits
+    bool m_primed;
+};
+
+template <typename First, typename Second>
+class FilterChain {
+public:
+    /// Push through First, then push First's output through Second
+    Temperature Push(Temperature reading);
+
+    void Reset();
+
+private:
+    First m_first;
+    Second m_second;
+};
+
+template <typename Filter>
+class Oversampler {
+public:
+    Oversampler();
+
+    /// Add one reading to the current burst
+    void Add(Temperature reading);
+
+    /**
+     * @brief Filtered value of the current burst; starts a new burst
+     * @return false if no reading was added since the last Collapse()
+     */
+    bool Collapse(Temperature& value);
+
+    /// Readings in the current burst
+    uint16_t GetCount() const;
+
+private:
+    Filter m_filter;
+    Temperature m_output;
+    uint16_t m_count;
+};
+
+// Inline implementations
+
+template <uint8_t N>
+inline MedianFilter<N>::MedianFilter() : m_window{}, m_next(0), m_count(0) {
+}
+
+template <uint8_t N>
+inline Temperature MedianFilter<N>::Push(Temperature reading) {
+    m_window[m_next] = reading.Raw();
+    m_next = static_cast<uint8_t>((m_next + 1) % N);
+    if (m_count < N) {
+        m_count++;
+    }
+
+    // Insertion sort of a copy of the ring: N is small
+    int16_t sorted[N];
+    for (uint8_t i = 0; i < m_count; i++) {
+        int16_t v = m_window[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+
+    uint8_t mid = static_cast<uint8_t>(m_count / 2);
+    if (m_count % 2 != 0) {
+        return Temperature::FromRaw(sorted[mid]);
+    }
+    // Even count: mean of the middle pair, rounded half away from zero
+    int32_t pair = static_cast<int32_t>(sorted[mid - 1]) + sorted[mid];
+    return Temperature::FromRaw(static_cast<int16_t>((pair + (pair >= 0 ? 1 : -1)) / 2));
+}
+
+template <uint8_t N>
+inline void MedianFilter<N>::Reset() {
+    m_next = 0;
+    m_count = 0;
+}
+
+template <uint8_t N>
+inline uint8_t MedianFilter<N>::GetCount() const {
+    return m_count;
+}
+
+template <uint8_t N>
+inline MovingAverage<N>::MovingAverage() : m_window{}, m_sum(0), m_next(0), m_count(0) {
+}
+
+template <uint8_t N>
+inline Temperature MovingAverage<N>::Push(Temperature reading) {
+    if (m_count == N) {
+        m_sum -= m_window[m_next];  // Oldest reading leaves the window
+    } else {
+        m_count++;
+    }
+    m_window[m_next] = reading.Raw();
+    m_sum += reading.Raw();
+    m_next = static_cast<uint8_t>((m_next + 1) % N);
+
+    // Round half away from zero so the mean is unbiased for negative data
+    int32_t half = m_count / 2;
+    int32_t mean = (m_sum >= 0 ? m_sum + half : m_sum - half) / m_count;
+    return Temperature::FromRaw(static_cast<int16_t>(mean));
+}
+
+template <uint8_t N>
+inline void MovingAverage<N>::Reset() {
+    m_sum = 0;
+    m_next = 0;
+    m_count = 0;
+}
+
+template <uint8_t N>
+inline uint8_t MovingAverage<N>::GetCount() const {
+    return m_count;
+}
+
+template <uint8_t Shift>
+inline IIRFilter<Shift>::IIRFilter() : m_state(0), m_primed(false) {
+}
+
+template <uint8_t Shift>
+inline Temperature IIRFilter<Shift>::Push(Temperature reading) {
+    const int32_t scale = static_cast<int32_t>(1) << Shift;
+    const int32_t half = scale / 2;
+    int32_t x = static_cast<int32_t>(reading.Raw()) * scale;
+
+    if (!m_primed) {
+        m_state = x;  // Start at the first reading instead of ramping from 0
+        m_primed = true;
+    } else {
+        // y += (x - y) / 2^Shift, kept at 2^Shift scale. The step is
+        // rounded, not truncated, so the state settles within half an
+        // output LSB of a constant input instead of stalling one LSB short
+        int32_t diff = x - m_state;
+        m_state += (diff >= 0 ? diff + half : diff - half) / scale;
+    }
+
+    // Round to the nearest 1/16 C
+    int32_t y = (m_state >= 0 ? m_state + half : m_state - half) / scale;
+    return Temperature::FromRaw(static_cast<int16_t>(y));
+}
+
+template <uint8_t Shift>
+inline void IIRFilter<Shift>::Reset() {
+    m_state = 0;
+    m_primed = false;
+}
+
+template <typename First, typename Second>
+inline Temperature FilterChain<First, Second>::Push(Temperature reading) {
+    return m_second.Push(m_first.Push(reading));
+}
+
+template <typename First, typename Second>
+inline void FilterChain<First, Second>::Reset() {
+    m_first.Reset();
+    m_second.Reset();
+}
+
+template <typename Filter>
+inline Oversampler<Filter>::Oversampler() : m_filter(), m_output(), m_count(0) {
+}
+
+template <typename Filter>
+inline void Oversampler<Filter>::Add(Temperature reading) {
+    m_output = m_filter.Push(reading);
+    if (m_count < UINT16_MAX) {
+        m_count++;
+    }
+}
+
+template <typename Filter>
+inline bool Oversampler<Filter>::Collapse(Temperature& value) {
+    if (m_count == 0) {
+        return false;
+    }
+    value = m_output;
+    m_filter.Reset();
+    m_count = 0;
+    return true;
+}
+
+template <typename Filter>
+inline uint16_t Oversampler<Filter>::GetCount() const {
+    return m_count;
+}
@@ -0,0 +1,321 @@
+/**
+ * @file TimedI2C.hpp
+ * @brief I2C bus timing model for host-side measurements
+ *
+ * The mocks complete every transaction instantly, so batching and caching
+ * changes cannot be compared off-target. TimedI2C wraps any controller
+ * (MockI2C, the test suite's RealI2CMock, ...) and keeps a simulated clock:
+ *
+ * - Bus time per transaction, in SCL periods (100 kHz / 400 kHz / 1 MHz):
+ *     START 1 + 9 per byte (8 bits + ACK) + STOP/bus free 1
+ *   The address byte counts as a byte; a repeated START costs 1 more
+ *   period and its own address byte.
+ * - 24xx EEPROMs (0x50-0x57): a write carrying data starts the internal
+ *   write cycle (tWC, default 5 ms). Until it ends the device NACKs its
+ *   address (the access costs START + address + STOP and is not passed
+ *   on), and each NACK is followed by the poll gap (default 100 us, the
+ *   driver's spin between ACK polls). The clock advances over the
+ *   cycle, so an ACK-poll loop takes as many polls as the real part.
+ * - TMP100s (0x48-0x4F): a one-shot trigger, or entering continuous
+ *   mode, starts a conversion (datasheet max: 75 ms at 9 bits, doubling
+ *   per bit). Reading the temperature register before it is done waits
+ *   for the result; that wait is reported separately.
+ *
+ * Advance() adds CPU time between transactions (a write cycle or a
+ * conversion can finish while the CPU works). Transactions are forwarded
+ * one at a time, including each entry of a Transfer() batch.
+ */
+
+#pragma once
+#include "II2CController.hpp"
+#include <cstdint>
+
+class TimedI2C final : public II2CController {
+public:
+    /// SCL frequency in Hz
+    enum class BusSpeed : uint32_t {
+        Standard  = 100000,   ///< 100 kHz
+        Fast      = 400000,   ///< 400 kHz
+        FastPlus  = 1000000   ///< 1 MHz
+    };
+
+    static constexpr uint32_t WRITE_CYCLE_US_DEFAULT = 5000;
+    static constexpr uint32_t POLL_GAP_US_DEFAULT = 100;
+    static constexpr uint32_t CONVERSION_US_9BIT = 75000;  ///< Max, doubles per bit
+
+    /// Time the transactions of bus at the given SCL frequency
+    explicit TimedI2C(II2CController& bus, BusSpeed speed = BusSpeed::Standard);
+
+    I2CStatus Write(uint8_t addr, const uint8_t* data, size_t len) override;
+    I2CStatus Read(uint8_t addr, uint8_t* buffer, size_t len) override;
+    I2CStatus WriteRead(uint8_t addr, const uint8_t* tx, size_t txLen,
+                        uint8_t* rx, size_t rxLen) override;
+    I2CStatus WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                     const uint8_t* data, size_t dataLen) override;
+    I2CStatus Transfer(I2CTransaction* list, size_t count) override;
+
+    void SetSpeed(BusSpeed speed);
+
+    /// EEPROM internal write cycle (tWC)
+    void SetWriteCycleUs(uint32_t us);
+
+    /// Idle time after each NACK of a busy EEPROM
+    void SetPollGapUs(uint32_t us);
+
+    /// CPU time between transactions
+    void Advance(uint32_t us);
+
+    /// Time SCL was running (transactions, including NACKed polls)
+    uint64_t GetBusMicros() const;
+
+    /// Simulated clock: bus time + write-cycle poll gaps + conversion waits + Advance()
+    uint64_t GetElapsedMicros() const;
+
+    /// Time spent waiting for TMP100 conversions at temperature reads
+    uint64_t GetConversionWaitMicros() const;
+
+    /// Transactions timed (NACKed polls included)
+    uint32_t GetTransactions() const;
+
+    /// Accesses NACKed because an EEPROM was in its write cycle
+    uint32_t GetBusyNacks() const;
+
+    /// Zero the counters and the clock; write cycles and conversions end
+    void Reset();
+
+private:
+    static constexpr uint8_t EEPROM_BASE = 0x50;
+    static constexpr uint8_t TMP100_BASE = 0x48;
+    static constexpr uint8_t EEPROM_ADDRESS_BYTES = 2;  ///< 24FC256 family
+
+    II2CController& m_bus;
+    uint32_t m_periodNs;          ///< One SCL period
+    uint32_t m_writeCycleNs;
+    uint32_t m_pollGapNs;
+    uint64_t m_nowNs;
+    uint64_t m_busNs;
+    uint64_t m_conversionWaitNs;
+    uint32_t m_transactions;
+    uint32_t m_busyNacks;
+    uint64_t m_eepromReadyNs[8];  ///< End of each EEPROM's write cycle
+    uint64_t m_tmpReadyNs[8];     ///< End of each TMP100's current conversion
+    uint8_t  m_tmpPointer[8];     ///< Register selected on each TMP100
+
+    /// Charge one transaction: `bytes` on the wire (address bytes included)
+    void Charge(size_t bytes, uint8_t starts);
+
+    /// Busy EEPROM: charge the NACKed address and the poll gap
+    bool RejectIfBusy(uint8_t addr);
+
+    /// Wait for a pending conversion before a TMP100 temperature read
+    void WaitForConversion(uint8_t addr, bool readsTemperature);
+
+    /// Track write cycles, pointers and conversions started by a write
+    void ObserveWrite(uint8_t addr, const uint8_t* header, size_t headerLen,
+                      const uint8_t* data, size_t dataLen);
+
+    static bool IsEeprom(uint8_t addr);
+    static bool IsTmp100(uint8_t addr);
+};
+
+// Inline implementations
+
+inline TimedI2C::TimedI2C(II2CController& bus, BusSpeed speed)
+    : m_bus(bus), m_periodNs(0), m_writeCycleNs(WRITE_CYCLE_US_DEFAULT * 1000),
+      m_pollGapNs(POLL_GAP_US_DEFAULT * 1000), m_nowNs(0), m_busNs(0), m_conversionWaitNs(0),
+      m_transactions(0), m_busyNacks(0), m_eepromReadyNs{}, m_tmpReadyNs{}, m_tmpPointer{} {
+    SetSpeed(speed);
+}
+
+inline bool TimedI2C::IsEeprom(uint8_t addr) {
+    return (addr & 0x78) == EEPROM_BASE;
+}
+
+inline bool TimedI2C::IsTmp100(uint8_t addr) {
+    return (addr & 0x78) == TMP100_BASE;
+}
+
+inline void TimedI2C::Charge(size_t bytes, uint8_t starts) {
+    uint64_t ns = static_cast<uint64_t>(starts + 1 + 9 * bytes) * m_periodNs;
+    m_nowNs += ns;
+    m_busNs += ns;
+    m_transactions++;
+}
+
+inline bool TimedI2C::RejectIfBusy(uint8_t addr) {
+    if (!IsEeprom(addr) || m_nowNs >= m_eepromReadyNs[addr & 0x07]) {
+        return false;
+    }
+    Charge(1, 1);
+    m_nowNs += m_pollGapNs;
+    m_busyNacks++;
+    return true;
+}
+
+inline void TimedI2C::WaitForConversion(uint8_t addr, bool readsTemperature) {
+    if (!IsTmp100(addr) || !readsTemperature) {
+        return;
+    }
+    uint64_t ready = m_tmpReadyNs[addr & 0x07];
+    if (m_nowNs < ready) {
+        m_conversionWaitNs += ready - m_nowNs;
+        m_nowNs = ready;
+    }
+}
+
+inline void TimedI2C::ObserveWrite(uint8_t addr, const uint8_t* header, size_t headerLen,
+                                   const uint8_t* data, size_t dataLen) {
+    size_t len = headerLen + dataLen;
+    if (IsEeprom(addr)) {
+        if (len > EEPROM_ADDRESS_BYTES) {
+            m_eepromReadyNs[addr & 0x07] = m_nowNs + m_writeCycleNs;
+        }
+        return;
+    }
+    if (!IsTmp100(addr) || len == 0) {
+        return;
+    }
+
+    // Pointer byte, then the configuration byte if the pointer selects it
+    uint8_t pointer = (headerLen > 0) ? header[0] : data[0];
+    uint8_t index = addr & 0x07;
+    m_tmpPointer[index] = pointer & 0x03;
+    if (m_tmpPointer[index] != 0x01 || len < 2) {
+        return;
+    }
+    uint8_t config = (headerLen > 1) ? header[1] : data[1 - headerLen];
+    bool shutdown = (config & 0x01) != 0;
+    bool oneShot = (config & 0x80) != 0;
+    if (!shutdown || oneShot) {
+        // Continuous mode restarts converting at each configuration write
+        uint8_t bits = static_cast<uint8_t>((config >> 5) & 0x03);
+        m_tmpReadyNs[index] = m_nowNs + (static_cast<uint64_t>(CONVERSION_US_9BIT) << bits) * 1000;
+    }
+}
+
+inline I2CStatus TimedI2C::Write(uint8_t addr, const uint8_t* data, size_t len) {
+    if (RejectIfBusy(addr)) {
+        return I2CStatus::Nack;
+    }
+    Charge(1 + len, 1);
+    I2CStatus status = m_bus.Write(addr, data, len);
+    if (status == I2CStatus::OK) {
+        ObserveWrite(addr, data, len, nullptr, 0);
+    }
+    return status;
+}
+
+inline I2CStatus TimedI2C::Read(uint8_t addr, uint8_t* buffer, size_t len) {
+    if (RejectIfBusy(addr)) {
+        return I2CStatus::Nack;
+    }
+    WaitForConversion(addr, m_tmpPointer[addr & 0x07] == 0x00);
+    Charge(1 + len, 1);
+    return m_bus.Read(addr, buffer, len);
+}
+
+inline I2CStatus TimedI2C::WriteRead(uint8_t addr, const uint8_t* tx, size_t txLen,
+                                     uint8_t* rx, size_t rxLen) {
+    if (RejectIfBusy(addr)) {
+        return I2CStatus::Nack;
+    }
+    if (IsTmp100(addr) && txLen > 0) {
+        m_tmpPointer[addr & 0x07] = tx[0] & 0x03;
+    }
+    WaitForConversion(addr, m_tmpPointer[addr & 0x07] == 0x00);
+    Charge(2 + txLen + rxLen, 2);
+    return m_bus.WriteRead(addr, tx, txLen, rx, rxLen);
+}
+
+inline I2CStatus TimedI2C::WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                                  const uint8_t* data, size_t dataLen) {
+    if (RejectIfBusy(addr)) {
+        return I2CStatus::Nack;
+    }
+    Charge(1 + headerLen + dataLen, 1);
+    I2CStatus status = m_bus.WriteV(addr, header, headerLen, data, dataLen);
+    if (status == I2CStatus::OK) {
+        ObserveWrite(addr, header, headerLen, data, dataLen);
+    }
+    return status;
+}
+
+inline I2CStatus TimedI2C::Transfer(I2CTransaction* list, size_t count) {
+    I2CStatus result = I2CStatus::OK;
+    for (size_t i = 0; i < count; i++) {
+        I2CTransaction& t = list[i];
+        if (RejectIfBusy(t.addr)) {
+            t.status = I2CStatus::Nack;
+        } else if (t.rxLen == 0) {
+            Charge(1 + t.headerLen + t.dataLen, 1);
+            m_bus.Transfer(&t, 1);
+            if (t.status == I2CStatus::OK) {
+                ObserveWrite(t.addr, t.header, t.headerLen, t.data, t.dataLen);
+            }
+        } else {
+            size_t tx = t.headerLen + t.dataLen;
+            if (IsTmp100(t.addr) && t.headerLen > 0) {
+                m_tmpPointer[t.addr & 0x07] = t.header[0] & 0x03;
+            }
+            WaitForConversion(t.addr, m_tmpPointer[t.addr & 0x07] == 0x00);
+            if (tx == 0) {
+                Charge(1 + t.rxLen, 1);
+            } else {
+                Charge(2 + tx + t.rxLen, 2);
+            }
+            m_bus.Transfer(&t, 1);
+        }
+        if (result == I2CStatus::OK) {
+            result = t.status;
+        }
+    }
+    return result;
+}
+
+inline void TimedI2C::SetSpeed(BusSpeed speed) {
+    m_periodNs = 1000000000u / static_cast<uint32_t>(speed);
+}
+
+inline void TimedI2C::SetWriteCycleUs(uint32_t us) {
+    m_writeCycleNs = us * 1000;
+}
+
+inline void TimedI2C::SetPollGapUs(uint32_t us) {
+    m_pollGapNs = us * 1000;
+}
+
+inline void TimedI2C::Advance(uint32_t us) {
+    m_nowNs += static_cast<uint64_t>(us) * 1000;
+}
+
+inline uint64_t TimedI2C::GetBusMicros() const {
+    return m_busNs / 1000;
+}
+
+inline uint64_t TimedI2C::GetElapsedMicros() const {
+    return m_nowNs / 1000;
+}
+
+inline uint64_t TimedI2C::GetConversionWaitMicros() const {
+    return m_conversionWaitNs / 1000;
+}
+
+inline uint32_t TimedI2C::GetTransactions() const {
+    return m_transactions;
+}
+
+inline uint32_t TimedI2C::GetBusyNacks() const {
+    return m_busyNacks;
+}
+
+inline void TimedI2C::Reset() {
+    m_nowNs = 0;
+    m_busNs = 0;
+    m_conversionWaitNs = 0;
+    m_transactions = 0;
+    m_busyNacks = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        m_eepromReadyNs[i] = 0;
+        m_tmpReadyNs[i] = 0;
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * @file SysTickTimer.cpp
+ * @brief SysTick programming, WFI sleep and the SysTick exception handler
+ *
+ * Cortex-M3 core registers (ARMv7-M ARM, B3.3):
+ *   SYST_CSR  0xE000E010  ENABLE (bit 0), TICKINT (bit 1), CLKSOURCE (bit 2)
+ *   SYST_RVR  0xE000E014  reload value, 24 bits
+ *   SYST_CVR  0xE000E018  current value; any write clears it
+ *   SCB_SCR   0xE000ED10  SLEEPDEEP (bit 2)
+ *
+ * Host builds (unit tests) have no SysTick: Init() only resets the
+ * counters, and every WFI is answered by one SysTick_Handler() call, so
+ * SleepUntil() and SleepTicks() advance simulated time tick by tick.
+ */
+
+#include "SysTickTimer.hpp"
+#include <cstdint>
+
+extern "C" void SysTick_Handler(void);
+
+namespace {
+
+#if defined(__arm__)
+volatile uint32_t* const SYST_CSR = reinterpret_cast<volatile uint32_t*>(0xE000E010);
+volatile uint32_t* const SYST_RVR = reinterpret_cast<volatile uint32_t*>(0xE000E014);
+volatile uint32_t* const SYST_CVR = reinterpret_cast<volatile uint32_t*>(0xE000E018);
+volatile uint32_t* const SCB_SCR  = reinterpret_cast<volatile uint32_t*>(0xE000ED10);
+
+const uint32_t CSR_ENABLE    = 1u << 0;
+const uint32_t CSR_TICKINT   = 1u << 1;
+const uint32_t CSR_CLKSOURCE = 1u << 2;  ///< Processor clock (not the external /8 reference)
+const uint32_t SCR_SLEEPDEEP = 1u << 2;
+#endif
+
+/// Timer the handler forwards ticks to (set by Init())
+SysTickTimer* g_activeTimer = nullptr;
+
+inline void WaitForInterrupt() {
+#if defined(__arm__)
+    __asm volatile ("wfi" ::: "memory");
+#else
+    SysTick_Handler();  // Host: the next interrupt is one tick
+#endif
+}
+
+}  // namespace
+
+void SysTickTimer::Init() {
+#if defined(__arm__)
+    *SYST_CSR = 0;  // Stop while reprogramming
+#endif
+    m_seconds = 0;
+    m_subTicks = 0;
+    m_ticks = 0;
+    g_activeTimer = this;
+
+#if defined(__arm__)
+    // At 100 Hz the 24-bit reload covers core clocks up to ~1.6 GHz
+    *SYST_RVR = ReloadFor(m_coreHz) & MAX_RELOAD;
+    *SYST_CVR = 0;
+    *SCB_SCR &= ~SCR_SLEEPDEEP;  // WFI must keep the core clock (and SysTick) running
+    *SYST_CSR = CSR_CLKSOURCE | CSR_TICKINT | CSR_ENABLE;
+#endif
+}
+
+void SysTickTimer::SleepUntil(uint32_t deadline) {
+    // A tick landing between the check and WFI is not lost: the next
+    // one wakes the core again, at most one tick late
+    while (!Reached(m_seconds, deadline)) {
+        WaitForInterrupt();
+    }
+}
+
+void SysTickTimer::SleepTicks(uint32_t ticks) {
+    uint32_t start = m_ticks;
+    while (m_ticks - start < ticks) {
+        WaitForInterrupt();
+    }
+}
+
+extern "C" void SysTick_Handler(void) {
+    if (g_activeTimer != nullptr) {
+        g_activeTimer->OnTick();
+    }
+}
@@ -2,105 +2,237 @@
  * @file main.cpp
  * @brief Temperature logger - logs every 10 minutes
  * 
- * Uses MockI2C and MockTimer for testing in QEMU - main is for gdb, test_logger is for unit testing
+ * Uses MockI2C for testing in QEMU - main is for gdb, test_logger is for unit testing
+ * Time comes from SysTick (SysTickTimer); between events the core sleeps in WFI
  * test_logger shows a complete test suite with realistic I2C behavior and should be run for evidence of correctness.
  */
 
 #include "MockI2C.hpp"
-#include "MockTimer.hpp"
+#include "RetryI2C.hpp"
+#include "SysTickTimer.hpp"
 #include "TMP100.hpp"
+#include "TMP100Array.hpp"
+#include "TemperatureFilter.hpp"
 #include "EEPROM24FC256.hpp"
+#include "RollupLog.hpp"
+#include "SweepLog.hpp"
 #include <cstdint>
 
 // Global variables visible in GDB
 volatile uint32_t g_sampleCount = 0;
-volatile float g_lastTemperature = 0.0f;
+volatile int32_t g_lastTemperature = 0;  // Hundredths of a deg C (2150 = 21.50 C)
 volatile uint16_t g_eepromAddress = 0;
 volatile bool g_initSuccess = false;
 volatile bool g_readSuccess = false;
 volatile bool g_writeSuccess = false;
 volatile int16_t g_lastEncoded = 0;
+volatile bool g_alertActive = false;
+volatile uint32_t g_excursions = 0;
+volatile uint8_t g_sensorMask = 0;
+volatile uint32_t g_busRetries = 0;    // Transactions repeated by the retry layer
+volatile uint32_t g_busFailures = 0;   // Transactions that failed every attempt
 
 // Status string (view in GDB: x/s g_status)
 const char* g_status = "Starting...";
 
+// Retry backoff: sleep for whole SysTick ticks (10 ms each)
+static void BackoffWait(void* timer, uint32_t ticks) {
+    static_cast<SysTickTimer*>(timer)->SleepTicks(ticks);
+}
+
 int main() {
+    g_status = "Creating timer";
+    SysTickTimer timer(SysTickTimer::DEFAULT_CORE_HZ);
+    timer.Init();
+    
     g_status = "Creating I2C controller";
     MockI2C i2cBus;
     
-    g_status = "Creating timer";
-    MockTimer timer;
-    timer.Init();
+    // Transient bus faults cost a retry instead of a sample: up to 2
+    // retries, 1 then 2 ticks apart (slept, not spun); an absent device
+    // stops being retried after 3 failed transactions in a row
+    using SensorBus = RetryI2CT<MockI2C>;
+    const RetryPolicy RETRY_POLICY = { 2, 1, 4, 3 };
+    SensorBus retryBus(i2cBus, RETRY_POLICY, RetryHooks{ &BackoffWait, nullptr, &timer });
     
-    g_status = "Creating TMP100 sensor";
-    TMP100 tempSensor(i2cBus, 0x48);
-    // TMP100 I2C address is 0x48
+    g_status = "Creating TMP100 sensors";
+    // TMP100 I2C addresses are 0x48 .. 0x48 + SENSOR_COUNT - 1
+    // Bound to the retry layer over MockI2C: sensor transactions are
+    // direct calls
+    const uint8_t SENSOR_COUNT = 4;
+    using SensorArray = TMP100Array<SENSOR_COUNT, SensorBus>;
+    SensorArray sensors(retryBus);
+    // Sensor 0 drives the rollups and the thermostat band
+    TMP100T<SensorBus>& tempSensor = sensors[0];
     
     g_status = "Creating EEPROM logger";
-    EEPROM24FC256 dataLogger(i2cBus, 0x50);
+    // The log layers take EEPROM24FC256&, so the EEPROM stays on the
+    // II2CController adapter
+    EEPROM24FC256 dataLogger(retryBus, 0x50);
     //   EEPROM I2C address is 0x50
     
+    // Write cycles run in the background and are finished by Poll()
+    dataLogger.SetAsyncWrites(true);
+    
+    // Pages 0-383: raw ring plus hourly/daily rollups of sensor 0 (22
+    // days raw, 42 days hourly, 2.8 years daily). Pages 384-511: one
+    // record per sweep with every channel (512 sweeps, 3.5 days). Both
+    // write heads, and the open hour and day, survive resets.
+    const uint16_t ROLLUP_PAGES = 128;
+    const uint16_t SWEEP_FIRST_PAGE = 3 * ROLLUP_PAGES;
+    const uint16_t SWEEP_PAGES = SweepLog::DEVICE_PAGES - SWEEP_FIRST_PAGE;
+    g_status = "Recovering log heads";
+    RollupLog rollupLog(dataLogger, ROLLUP_PAGES, ROLLUP_PAGES, ROLLUP_PAGES);
+    rollupLog.Recover();
+    SweepLog sweepLog(dataLogger, SensorArray::RECORD_BYTES, SWEEP_FIRST_PAGE, SWEEP_PAGES);
+    sweepLog.Recover();
+    
+    // SysTick restarts at 0 on every reset: log timestamps continue from
+    // the newest recovered record so they never go backwards in either log
+    const uint32_t timeBase = (rollupLog.GetLastTime() > sweepLog.GetLastTime())
+        ? rollupLog.GetLastTime() : sweepLog.GetLastTime();
+    
+    // Event-driven logging: the sensor's thermostat watches the band on
+    // every conversion, so it must convert continuously. Without it the
+    // sensor is shut down between samples (one-shot).
+    const bool EVENT_LOGGING = true;
+    const Temperature BAND_LOW = Temperature::FromDegrees(18);
+    const Temperature BAND_HIGH = Temperature::FromDegrees(27);
+    const uint32_t LOG_INTERVAL = 600;        // Routine sample
+    const uint32_t EXCURSION_INTERVAL = 60;   // Sample period while out of band
+    const uint32_t ALERT_CHECK_INTERVAL = 60; // One-byte thermostat status read
+    
+    // Sensor 0 is also read on every alert check, so each logged value is
+    // collapsed from ~10 readings: median of 5 drops drafts and spikes,
+    // then the last 4 medians are averaged
+    Oversampler<FilterChain<MedianFilter<5>, MovingAverage<4>>> smoothing;
+    
     g_status = "Initializing TMP100";
-    g_initSuccess = tempSensor.Init();
+    if (EVENT_LOGGING) {
+        sensors.Init(TMP100Base::ConversionMode::Continuous);
+        g_initSuccess = tempSensor.SetThresholds(BAND_LOW, BAND_HIGH) &&
+                        tempSensor.ConfigureAlert(TMP100Base::AlertMode::Comparator,
+                                                  TMP100Base::FaultQueue::Faults_2);
+    } else {
+        g_initSuccess = sensors.Init(TMP100Base::ConversionMode::OneShot);
+    }
+    g_sensorMask = sensors.GetPresentMask();
+    
+    // Start each conversion early enough to finish by the log deadline
+    const uint32_t conversionLead = (sensors.GetConversionTimeMs() + 999) / 1000;
+    bool conversionStarted = false;
     
-    uint16_t eepromAddress = 0;
     uint32_t lastLogTime = 0;
+    uint32_t lastAlertCheck = 0;
+    bool logNow = false;
     g_status = "Entering main loop";
     
     // sample for max capacity of EEPROM w/ 2 byte samples (16384 times)
     while (g_sampleCount < 16384) {
         uint32_t currentTime = timer.GetElapsedSeconds();
         
-        // Check if 10 minutes (600 seconds) have elapsed from 1Hz tick simulation
-        if (currentTime - lastLogTime >= 600) {
-            g_status = "Reading temperature";
-            float temperature = tempSensor.ReadTemperature();
+        // Retire an in-flight EEPROM write cycle without blocking
+        dataLogger.Poll();
+        
+        // Band crossings are detected by the sensor; an edge is logged at
+        // once and the sample period drops to EXCURSION_INTERVAL while out
+        if (EVENT_LOGGING && currentTime - lastAlertCheck >= ALERT_CHECK_INTERVAL) {
+            g_status = "Checking alert";
+            lastAlertCheck = currentTime;
+            bool active = false;
+            if (tempSensor.ReadAlert(active) && active != g_alertActive) {
+                g_alertActive = active;
+                if (active) {
+                    g_excursions++;
+                }
+                logNow = true;
+            }
             
-            if (temperature < -900.0f) {
+            Temperature reading;
+            if (tempSensor.ReadTemperature(reading)) {
+                smoothing.Add(reading);
+            }
+        }
+        uint32_t interval = g_alertActive ? EXCURSION_INTERVAL : LOG_INTERVAL;
+        
+        uint32_t elapsed = currentTime - lastLogTime;
+        if (!conversionStarted && elapsed >= interval - conversionLead) {
+            g_status = "Starting conversion";
+            // A failed trigger shows up as a failed read at the deadline
+            sensors.TriggerAll();
+            conversionStarted = true;
+        }
+        
+        // Check if the interval (10 minutes when in band) has elapsed;
+        // currentTime is whole seconds counted by the 100 Hz SysTick
+        if (logNow || elapsed >= interval) {
+            g_status = "Reading temperatures";
+            // One sweep: a single read per present sensor, results in Q12.4
+            int16_t channels[SENSOR_COUNT];
+            uint8_t mask = sensors.Sweep(channels);
+            g_readSuccess = (mask & 0x01) != 0;
+            
+            // Fixed point end to end: no soft-float calls per sample
+            if (g_readSuccess) {
+                smoothing.Add(Temperature::FromRaw(channels[0]));
+            }
+            
+            g_status = "Filtering temperature";
+            Temperature temperature;
+            if (!smoothing.Collapse(temperature)) {
                 // Simulate read failure
-                g_readSuccess = false;
-                temperature = 20.0f + (float)(g_sampleCount * 0.01f);
+                temperature = Temperature::FromCentiDegrees(2000 + (int32_t)g_sampleCount);
                 // Provide dummy temperature for testing
-            } else {
-                g_readSuccess = true;
             }
             
-            g_lastTemperature = temperature;
-            
-            g_status = "Encoding temperature";
-            int16_t encoded = (int16_t)(temperature * 16.0f);
+            g_lastTemperature = temperature.CentiDegrees();
             // Store last encoded value for inspection
-            g_lastEncoded = encoded;
+            g_lastEncoded = temperature.Raw();
             
             g_status = "Writing to EEPROM";
-            g_writeSuccess = dataLogger.LogData(eepromAddress, temperature);
+            // Units brown out often, so every sample is made durable, but
+            // only the raw and sweep head pages are flushed: two write
+            // cycles per sample. Flushing the open hourly/daily records too
+            // would cost two more, and Recover() rebuilds them from the raw
+            // samples anyway. Records are still written once when their
+            // period closes.
+            uint32_t logTime = timeBase + currentTime;
+            bool rollupOk = rollupLog.Append(temperature, logTime) && rollupLog.GetRaw().Flush();
+            bool sweepOk = SensorArray::LogSweep(sweepLog, logTime, channels, mask) && sweepLog.Flush();
+            g_writeSuccess = rollupOk && sweepOk;
             
-            g_status = "Updating address";
+            I2CDeviceStats bus = retryBus.GetTotals();
+            g_busRetries = bus.retries;
+            g_busFailures = bus.failures;
             
-            // Update EEPROM address (circular buffer)
-            eepromAddress += 2;
-            if (eepromAddress >= 32766) {
-                eepromAddress = 0;  // Wrap around
-            }
+            g_status = "Updating address";
             
-            g_eepromAddress = eepromAddress;
+            // Raw ring wraps around at the end of its region (circular buffer)
+            g_eepromAddress = rollupLog.GetRaw().GetHeadPage() * EEPROM24FC256::PAGE_SIZE;
             
             g_status = "Incrementing counter";
             g_sampleCount++;
             
             // Update last log time for next 10-minute interval
             lastLogTime = currentTime;
-            
-            // For QEMU testing: advance timer quickly
-            // In real hardware: this loop would block/sleep until next interrupt
-            timer.AdvanceTime(600);
+            conversionStarted = false;
+            logNow = false;
+        }
+        
+        // Sleep until the next event; SysTick wakes the core every tick
+        // and SleepUntil() goes back to sleep until the deadline
+        uint32_t nextEvent = lastLogTime + interval - (conversionStarted ? 0 : conversionLead);
+        if (EVENT_LOGGING && lastAlertCheck + ALERT_CHECK_INTERVAL < nextEvent) {
+            nextEvent = lastAlertCheck + ALERT_CHECK_INTERVAL;
         }
+        uint32_t now = timer.GetElapsedSeconds();
+        timer.SleepUntil(nextEvent > now ? nextEvent : now + 1);
     }
     
     g_status = "Done";
     
     while (1) {
-        for (volatile uint32_t i = 0; i < 0x00100000; i++);
+        timer.SleepUntil(timer.GetElapsedSeconds() + 3600);
     }
     
     return 0;
@@ -6,7 +6,7 @@
  * - Initial stack pointer
  * - Vector table with all exception/interrupt handlers
  * - Reset handler (system entry point)
- * - Default exception handlers (infinite loops)
+ * - Default exception handlers (infinite loops), weak so C++ can override them
  * - BSS and data section initialization
  */
 
@@ -119,10 +119,23 @@ bss_init_check:
  * These are placeholders that halt execution.
  * In production, would implement proper handlers:
  * - HardFault: Log registers, reset
- * - SysTick: Increment tick counter
  * - etc.
+ * 
+ * All are weak: a C++ definition with the same name (extern "C")
+ * replaces the default at link time. SysTick_Handler is provided by
+ * src/SysTickTimer.cpp.
  */
 
+    .weak NMI_Handler
+    .weak HardFault_Handler
+    .weak MemManage_Handler
+    .weak BusFault_Handler
+    .weak UsageFault_Handler
+    .weak SVC_Handler
+    .weak DebugMon_Handler
+    .weak PendSV_Handler
+    .weak SysTick_Handler
+
     .thumb_func
 NMI_Handler:
     b .
@@ -164,7 +177,7 @@ PendSV_Handler:
 
     .thumb_func
 SysTick_Handler:
-    /* Could increment tick counter here */
+    /* Default: ignore the tick (SysTickTimer.cpp overrides this) */
     bx lr  /* Return from interrupt */
 
     .end
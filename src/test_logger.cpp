@@ -11,13 +11,29 @@
  */
 
 #include "TMP100.hpp"
+#include "TMP100Array.hpp"
 #include "EEPROM24FC256.hpp"
+#include "EEPROMPageWriter.hpp"
+#include "CompressedLog.hpp"
+#include "LogRing.hpp"
+#include "EEPROMVolume.hpp"
+#include "RollupLog.hpp"
+#include "SweepLog.hpp"
+#include "TemperatureFilter.hpp"
 #include "II2CController.hpp"
+#include "MockI2C.hpp"
+#include "MockAsyncI2C.hpp"
+#include "AsyncPageWriter.hpp"
+#include "TimedI2C.hpp"
+#include "I2CRecorder.hpp"
+#include "RetryI2C.hpp"
 #include "MockTimer.hpp"
+#include "SysTickTimer.hpp"
 #include <cstdint>
 #include <cstdio>
 #include <cmath>
 #include <cstring>
+#include <type_traits>
 
 // ============================================================================
 // Simulated I2C Controller (behaves like real TMP100 + EEPROM24FC256)
@@ -28,7 +44,7 @@
  * - TMP100 temperature sensor at address 0x48
  * - EEPROM24FC256 at address 0x50
  */
-class RealI2CMock : public II2CController {
+class RealI2CMock final : public II2CController {
 private:
     static constexpr uint16_t EEPROM_SIZE = 32768;
     uint8_t m_eepromData[EEPROM_SIZE] = {0};  // Simulated EEPROM memory
@@ -36,6 +52,26 @@ private:
     
     float m_simulatedTemp = 22.5f;  // Current simulated temperature
     
+    // TMP100 register file (power-on: continuous, 9-bit, TLOW 75C, THIGH 80C)
+    uint8_t  m_tmpPointer = 0;        // Pointer register
+    uint8_t  m_tmpConfig = 0x00;      // Configuration register (OS not stored)
+    uint16_t m_tmpResult = 0;         // Temperature register while shut down
+    uint16_t m_tmpLimits[2] = { 0x4B00, 0x5000 };  // TLOW, THIGH
+    uint32_t m_tmpWrites = 0;         // Write transactions to the sensor
+    uint32_t m_tmpReads = 0;          // Read transactions from the sensor
+    uint32_t m_tmpConversions = 0;    // One-shot conversions triggered
+    bool     m_tmpAlert = false;      // Thermostat output active
+    bool     m_tmpHighSide = false;   // Interrupt mode: last event was a THIGH crossing
+    uint8_t  m_tmpFaults = 0;         // Consecutive out-of-band conversions
+    
+    uint32_t m_eepromDataWrites = 0;  // Write transactions carrying data
+    uint32_t m_eepromBusBytes = 0;    // Bytes sent in those transactions
+    uint32_t m_eepromReads = 0;       // Read transactions
+    
+    uint32_t m_writeCyclePolls = 0;   // Accesses NACKed after each data write
+    uint32_t m_busyRemaining = 0;     // NACKs left in current write cycle
+    uint32_t m_eepromNacks = 0;       // Accesses NACKed while busy
+    
 public:
     RealI2CMock() {
         // Initialize EEPROM to 0xFF (erased state)
@@ -47,6 +83,17 @@ public:
      */
     void SetSimulatedTemperature(float temp) {
         m_simulatedTemp = temp;
+        if (!(m_tmpConfig & 0x01)) {
+            RunConversion();  // Continuous mode: sensor converts the new value
+        }
+    }
+    
+    /**
+     * @brief Make the EEPROM NACK the next n accesses after each data write
+     * (simulates the internal write cycle seen by ACK polling)
+     */
+    void SetWriteCyclePolls(uint32_t n) {
+        m_writeCyclePolls = n;
     }
     
     /**
@@ -54,19 +101,45 @@ public:
      */
     I2CStatus Write(uint8_t addr, const uint8_t* data, size_t len) override {
         if (addr == 0x48) {  // TMP100 address
-            // TMP100 register write (configuration)
-            // Format: register address (1 byte) + data
+            // Format: pointer register (1 byte) + optional register data
+            m_tmpWrites++;
             if (len >= 1) {
-                // Ignore for now (init sets config)
-                return I2CStatus::OK;
+                m_tmpPointer = data[0] & 0x03;
+            }
+            if (len >= 2 && m_tmpPointer == 0x01) {
+                uint8_t config = data[1];
+                if ((config & 0x01) && !(m_tmpConfig & 0x01)) {
+                    m_tmpResult = ConvertTemperature();  // Last result held in shutdown
+                }
+                m_tmpConfig = config & 0x7F;
+                if ((config & 0x01) && (config & 0x80)) {
+                    RunConversion();  // One-shot conversion
+                    m_tmpConversions++;
+                }
+            } else if (len >= 3 && m_tmpPointer >= 0x02) {
+                m_tmpLimits[m_tmpPointer - 2] = ((uint16_t)data[1] << 8) | data[2];
             }
+            return I2CStatus::OK;
         } else if (addr == 0x50) {  // EEPROM address (24FC256)
+            // Internal write cycle in progress: device does not ACK
+            if (m_busyRemaining > 0) {
+                m_busyRemaining--;
+                m_eepromNacks++;
+                return I2CStatus::Nack;
+            }
+            
             // EEPROM write format: [addr_hi][addr_lo][data...]
             if (len >= 2) {
                 // First two bytes are address (even if no data)
                 uint16_t memAddr = ((uint16_t)data[0] << 8) | data[1];
                 m_eepromAddrPointer = memAddr;
                 
+                if (len > 2) {
+                    m_eepromDataWrites++;
+                    m_eepromBusBytes += len;
+                    m_busyRemaining = m_writeCyclePolls;
+                }
+                
                 // Write data bytes if provided
                 for (size_t i = 2; i < len && memAddr + i - 2 < EEPROM_SIZE; i++) {
                     m_eepromData[memAddr + i - 2] = data[i];
@@ -79,27 +152,42 @@ public:
     
     I2CStatus Read(uint8_t addr, uint8_t* buffer, size_t len) override {
         if (addr == 0x48) {  // TMP100 read
+            m_tmpReads++;
+            
             // TMP100 returns temperature in 2-byte format
             // Format: [temp_hi][temp_lo]
             // 12-bit resolution: temp_hi contains integer, temp_lo[7:4] contains fraction
             
+            // Register selected by the pointer register
+            uint16_t reg = 0;
+            if (m_tmpPointer == 0x00) {
+                // Shut down: result of the last conversion, else live value
+                reg = (m_tmpConfig & 0x01) ? m_tmpResult : ConvertTemperature();
+            } else if (m_tmpPointer == 0x01) {
+                // OS/ALERT reads the thermostat output; POL = 0 -> 0 while active
+                uint8_t pol = (m_tmpConfig >> 2) & 0x01;
+                uint8_t os = m_tmpAlert ? pol : (uint8_t)(pol ^ 1);
+                uint8_t config = (uint8_t)(m_tmpConfig | (os << 7));
+                reg = (uint16_t)((config << 8) | config);
+            } else {
+                reg = m_tmpLimits[m_tmpPointer - 2];
+            }
+            
+            if (m_tmpConfig & 0x02) {
+                m_tmpAlert = false;  // Interrupt mode: any read clears the alert
+            }
+            
+            if (len >= 1) {
+                buffer[0] = (reg >> 8) & 0xFF;  // High byte
+            }
             if (len >= 2) {
-                // Convert temperature to raw 12-bit value
-                // Q12.4 format: multiply by 16 and convert to 16-bit signed
-                int16_t raw = (int16_t)(m_simulatedTemp * 16.0f);
-                
-                // Shift left 4 bits to match hardware format
-                raw = raw << 4;
-                
-                // Convert to big-endian bytes
-                buffer[0] = (raw >> 8) & 0xFF;  // High byte
-                buffer[1] = raw & 0xFF;         // Low byte
-                
-                return I2CStatus::OK;
+                buffer[1] = reg & 0xFF;         // Low byte
             }
+            return I2CStatus::OK;
         } else if (addr == 0x50) {  // EEPROM read
             // Read from current address pointer
             // (Pointer was set by previous Write call)
+            m_eepromReads++;
             
             for (size_t i = 0; i < len && m_eepromAddrPointer + i < EEPROM_SIZE; i++) {
                 buffer[i] = m_eepromData[m_eepromAddrPointer + i];
@@ -113,6 +201,63 @@ public:
         return I2CStatus::OK;
     }
     
+    /**
+     * @brief Temperature register value for the simulated temperature
+     * 
+     * Q12.4 left-justified (raw << 4), low bits cleared below the
+     * configured resolution (9..12 bits)
+     */
+    uint16_t ConvertTemperature() const {
+        int16_t raw = (int16_t)(m_simulatedTemp * 16.0f);
+        raw = raw << 4;
+        uint8_t bits = 9 + ((m_tmpConfig >> 5) & 0x03);
+        uint16_t mask = (uint16_t)(0xFFFF << (16 - bits));
+        return (uint16_t)raw & mask;
+    }
+    
+    /**
+     * @brief One conversion: latch the result and run the thermostat
+     * 
+     * Comparator (TM = 0): alert set after N conversions >= THIGH,
+     * cleared after N conversions < TLOW. Interrupt (TM = 1): alert set
+     * on each such crossing, alternating sides, cleared by a read.
+     */
+    void RunConversion() {
+        m_tmpResult = ConvertTemperature();
+        
+        int16_t t = (int16_t)m_tmpResult;
+        bool interrupt = (m_tmpConfig & 0x02) != 0;
+        bool watchHigh = interrupt ? !m_tmpHighSide : !m_tmpAlert;
+        bool fault = watchHigh ? (t >= (int16_t)m_tmpLimits[1]) : (t < (int16_t)m_tmpLimits[0]);
+        m_tmpFaults = fault ? (uint8_t)(m_tmpFaults + 1) : 0;
+        
+        static const uint8_t QUEUE[4] = { 1, 2, 4, 6 };
+        if (m_tmpFaults >= QUEUE[(m_tmpConfig >> 3) & 0x03]) {
+            m_tmpFaults = 0;
+            if (interrupt) {
+                m_tmpHighSide = watchHigh;
+                m_tmpAlert = true;
+            } else {
+                m_tmpAlert = watchHigh;
+            }
+        }
+    }
+    
+    /// TMP100 TLOW (0) or THIGH (1) register as last written
+    uint16_t GetTmp100Limit(uint8_t index) const { return m_tmpLimits[index]; }
+    
+    /// TMP100 configuration register as last written (OS bit excluded)
+    uint8_t GetTmp100Config() const { return m_tmpConfig; }
+    
+    /// Write transactions addressed to the TMP100
+    uint32_t GetTmp100Writes() const { return m_tmpWrites; }
+    
+    /// Read transactions addressed to the TMP100
+    uint32_t GetTmp100Reads() const { return m_tmpReads; }
+    
+    /// One-shot conversions triggered on the TMP100
+    uint32_t GetTmp100Conversions() const { return m_tmpConversions; }
+    
     /**
      * @brief Read EEPROM data directly (for test verification)
      */
@@ -121,6 +266,85 @@ public:
             buffer[i] = m_eepromData[addr + i];
         }
     }
+    
+    /// Number of EEPROM write transactions that carried data (write cycles)
+    uint32_t GetEepromDataWrites() const { return m_eepromDataWrites; }
+    
+    /// Bytes (address + data) sent in EEPROM data writes
+    uint32_t GetEepromBusBytes() const { return m_eepromBusBytes; }
+    
+    /// Number of EEPROM read transactions
+    uint32_t GetEepromReads() const { return m_eepromReads; }
+    
+    /// Number of EEPROM accesses NACKed during a write cycle
+    uint32_t GetEepromNacks() const { return m_eepromNacks; }
+};
+
+/**
+ * @brief Mock I2C bus with up to eight 24FC256 devices at 0x50-0x57
+ * 
+ * Write cycle is modelled in bus time: after a data write a device NACKs
+ * until `cycleTransactions` more transactions have crossed the bus (to any
+ * device), so writes to other devices overlap the write cycle.
+ */
+class MultiEEPROMMock : public II2CController {
+private:
+    static constexpr uint8_t DEVICES = 8;
+    static constexpr uint32_t EEPROM_SIZE = 32768;
+    uint8_t m_memory[DEVICES][EEPROM_SIZE];
+    uint16_t m_pointer[DEVICES] = {0};
+    uint32_t m_busyUntil[DEVICES] = {0};
+    uint32_t m_cycleTransactions;
+    uint32_t m_transactions = 0;
+    uint32_t m_nacks = 0;
+    
+public:
+    explicit MultiEEPROMMock(uint32_t cycleTransactions)
+        : m_cycleTransactions(cycleTransactions) {
+        std::memset(m_memory, 0xFF, sizeof(m_memory));
+    }
+    
+    I2CStatus Write(uint8_t addr, const uint8_t* data, size_t len) override {
+        m_transactions++;
+        if (addr < 0x50 || addr >= 0x50 + DEVICES) {
+            return I2CStatus::Nack;
+        }
+        uint8_t dev = addr - 0x50;
+        if (m_transactions < m_busyUntil[dev]) {
+            m_nacks++;
+            return I2CStatus::Nack;  // Write cycle in progress
+        }
+        if (len >= 2) {
+            uint16_t memAddr = ((uint16_t)data[0] << 8) | data[1];
+            m_pointer[dev] = memAddr;
+            for (size_t i = 2; i < len; i++) {
+                m_memory[dev][(memAddr + i - 2) % EEPROM_SIZE] = data[i];
+            }
+            if (len > 2) {
+                m_busyUntil[dev] = m_transactions + m_cycleTransactions;
+            }
+        }
+        return I2CStatus::OK;
+    }
+    
+    I2CStatus Read(uint8_t addr, uint8_t* buffer, size_t len) override {
+        m_transactions++;
+        if (addr < 0x50 || addr >= 0x50 + DEVICES) {
+            return I2CStatus::Nack;
+        }
+        uint8_t dev = addr - 0x50;
+        for (size_t i = 0; i < len; i++) {
+            buffer[i] = m_memory[dev][(m_pointer[dev] + i) % EEPROM_SIZE];
+        }
+        m_pointer[dev] = static_cast<uint16_t>((m_pointer[dev] + len) % EEPROM_SIZE);
+        return I2CStatus::OK;
+    }
+    
+    /// ACK polls NACKed while waiting for a busy device
+    uint32_t GetNacks() const { return m_nacks; }
+    
+    /// Direct view of one device's memory (for test verification)
+    const uint8_t* GetMemory(uint8_t dev) const { return m_memory[dev]; }
 };
 
 // ============================================================================
@@ -483,6 +707,2312 @@ void TestTimer() {
     }
 }
 
+// ============================================================================
+// TEST 9: Page-Write Batching
+// ============================================================================
+
+void TestPageWriteBatching() {
+    TestHeader("TEST 9: Page-Write Batching");
+    
+    RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    
+    // Test: Raw page write inside one page, rejected across a boundary
+    uint8_t raw[4] = {0x01, 0x02, 0x03, 0x04};
+    Assert(eeprom.WritePage(60, raw, 4), "Page write ending at page boundary accepted");
+    Assert(!eeprom.WritePage(62, raw, 4), "Page write crossing page boundary rejected");
+    
+    // Test: LogData at the last sample slot of a page (address 62)
+    Assert(eeprom.LogData(62, 21.0f), "LogData at last slot of a page (62)");
+    AssertClose(eeprom.ReadData(62), 21.0f, 0.001f, "Read back last slot of a page");
+    
+    // Test: 64 samples staged through the page writer = 2 page writes
+    RealI2CMock i2c2;
+    EEPROM24FC256 eeprom2(i2c2, 0x50);
+    EEPROMPageWriter writer(eeprom2);
+    
+    bool allOk = true;
+    for (int i = 0; i < 64; i++) {
+        allOk = writer.Append(20.0f + (float)i * 0.0625f) && allOk;
+    }
+    Assert(allOk, "Appended 64 samples");
+    Assert(i2c2.GetEepromDataWrites() == 2, "64 samples cost 2 write cycles");
+    Assert(i2c2.GetEepromBusBytes() == 2 * (2 + 64), "64 samples cost 132 bus bytes");
+    Assert(writer.GetWriteAddress() == 128, "Write address advanced to 128");
+    
+    bool dataOk = true;
+    for (int i = 0; i < 64; i++) {
+        float expected = 20.0f + (float)i * 0.0625f;
+        if (eeprom2.ReadData(i * 2) != expected) {
+            dataOk = false;
+        }
+    }
+    Assert(dataOk, "All 64 batched samples read back correctly");
+    
+    // Test: Partial page is only written on explicit flush
+    writer.Append(30.0f);
+    writer.Append(31.0f);
+    Assert(writer.GetPendingSamples() == 2, "Two samples pending in RAM");
+    Assert(i2c2.GetEepromDataWrites() == 2, "Partial page not yet written");
+    Assert(writer.Flush(), "Flush partial page");
+    Assert(i2c2.GetEepromDataWrites() == 3, "Flush costs one write cycle");
+    AssertClose(eeprom2.ReadData(130), 31.0f, 0.001f, "Flushed sample read back");
+    
+    // Test: Continuing a flushed page only writes the new bytes
+    writer.Append(32.0f);
+    writer.Flush();
+    Assert(i2c2.GetEepromBusBytes() == 2 * (2 + 64) + (2 + 4) + (2 + 2),
+           "Second flush writes only the new sample");
+    
+    // Test: Writer wraps at the end of its region
+    EEPROMPageWriter ring(eeprom2, 32704);  // Last page of the device
+    for (int i = 0; i < 32; i++) {
+        ring.Append(25.0f);
+    }
+    Assert(ring.GetWriteAddress() == 32704, "Writer wraps to region start");
+    AssertClose(eeprom2.ReadData(32766), 25.0f, 0.001f, "Last device slot written");
+    
+    // Test: Odd addresses are rounded up to the next sample slot
+    ring.Seek(32767);
+    Assert(ring.GetWriteAddress() == 32704, "Seek to the last byte wraps instead of straddling");
+    ring.Seek(32765);
+    Assert(ring.GetWriteAddress() == 32766, "Odd Seek rounded up to the next sample");
+    Assert(ring.Append(Temperature::FromRaw(0x1234)) && ring.GetWriteAddress() == 32704,
+           "Last sample of the page fills it exactly");
+    Temperature last;
+    Assert(eeprom2.ReadData(32766, last) && last.Raw() == 0x1234, "Sample stored at the aligned slot");
+    EEPROMPageWriter oddStart(eeprom2, 1025);
+    Assert(oddStart.GetWriteAddress() == 1026, "Odd region start rounded up");
+}
+
+// ============================================================================
+// TEST 10: Bulk Sequential Read
+// ============================================================================
+
+void TestBulkSequentialRead() {
+    TestHeader("TEST 10: Bulk Sequential Read");
+    
+    RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    EEPROMPageWriter writer(eeprom);
+    
+    // Fill the whole device: sample i = i (as raw Q12.4)
+    const uint16_t SAMPLES = EEPROM24FC256::CAPACITY / 2;
+    for (uint16_t i = 0; i < SAMPLES; i++) {
+        writer.Append(static_cast<int16_t>(i - 8192));
+    }
+    
+    // Test: Whole-device dump in one bus transaction
+    static int16_t dump[EEPROM24FC256::CAPACITY / 2];
+    uint32_t readsBefore = i2c.GetEepromReads();
+    bool ok = eeprom.ReadRange(0, dump, SAMPLES);
+    Assert(ok, "Read all 16,384 samples");
+    Assert(i2c.GetEepromReads() - readsBefore == 1, "Whole dump costs one read transaction");
+    
+    bool dataOk = true;
+    for (uint16_t i = 0; i < SAMPLES; i++) {
+        if (dump[i] != static_cast<int16_t>(i - 8192)) {
+            dataOk = false;
+        }
+    }
+    Assert(dataOk, "All dumped samples decoded correctly");
+    
+    // Test: Range crossing the end of the ring wraps to address 0
+    int16_t tail[40];
+    readsBefore = i2c.GetEepromReads();
+    ok = eeprom.ReadRange(32728, tail, 40);  // 20 samples before end, 20 after
+    Assert(ok, "Read range across ring wrap");
+    Assert(i2c.GetEepromReads() - readsBefore == 2, "Wrapped range costs two transactions");
+    Assert(tail[0] == 16364 - 8192 && tail[19] == 16383 - 8192, "Samples before wrap correct");
+    Assert(tail[20] == -8192 && tail[39] == 19 - 8192, "Samples after wrap correct");
+    
+    // Test: Invalid requests
+    Assert(!eeprom.ReadRange(1, tail, 1), "Odd start address rejected");
+    Assert(!eeprom.ReadRange(0, tail, 0), "Zero-length range rejected");
+    Assert(!eeprom.ReadRange(0, dump, SAMPLES + 1), "Range larger than device rejected");
+    
+    // Test: Single-sample reads still work through the sequential read path
+    AssertClose(eeprom.ReadData(32766), (16383 - 8192) / 16.0f, 0.001f, "ReadData at last address");
+    AssertClose(eeprom.ReadData(32767), -999.0f, 0.001f, "ReadData past end returns error");
+}
+
+// ============================================================================
+// TEST 11: Non-Blocking Write Cycles
+// ============================================================================
+
+void TestAsyncWriteCycle() {
+    TestHeader("TEST 11: Non-Blocking Write Cycles");
+    
+    RealI2CMock i2c;
+    i2c.SetWriteCyclePolls(3);  // Device busy for 3 polls after each write
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    
+    // Test: Blocking mode waits for the write cycle inside LogData
+    Assert(eeprom.LogData(0, 20.0f), "Blocking write accepted");
+    Assert(!eeprom.IsBusy(), "Blocking write returns with device idle");
+    Assert(i2c.GetEepromNacks() == 3, "Blocking write ACK-polled through write cycle");
+    
+    // Test: Async mode returns right after the data is accepted
+    eeprom.SetAsyncWrites(true);
+    Assert(eeprom.LogData(2, 21.0f), "Async write accepted");
+    Assert(eeprom.IsBusy(), "Write cycle tracked as in flight");
+    Assert(i2c.GetEepromNacks() == 3, "No polling inside async LogData");
+    
+    // Test: Poll() finishes the write cycle one ACK poll at a time
+    int polls = 0;
+    while (!eeprom.Poll() && polls < 10) {
+        polls++;
+    }
+    Assert(polls == 3, "Poll() reported busy for 3 polls");
+    Assert(!eeprom.IsBusy(), "Poll() cleared in-flight write cycle");
+    Assert(eeprom.Poll(), "Poll() on idle device is free");
+    
+    // Test: Next access waits for the in-flight write cycle first
+    eeprom.LogData(4, 22.0f);
+    Assert(eeprom.IsBusy(), "Second async write in flight");
+    AssertClose(eeprom.ReadData(4), 22.0f, 0.001f, "Read after async write completes cycle first");
+    Assert(!eeprom.IsBusy(), "Read finished the in-flight write cycle");
+    
+    eeprom.LogData(6, 23.0f);
+    Assert(eeprom.LogData(8, 24.0f), "Back-to-back async writes accepted");
+    AssertClose(eeprom.ReadData(6), 23.0f, 0.001f, "First back-to-back sample intact");
+    AssertClose(eeprom.ReadData(8), 24.0f, 0.001f, "Second back-to-back sample intact");
+    
+    // Test: Switching back to blocking mode drains the pending cycle
+    eeprom.LogData(10, 25.0f);
+    eeprom.SetAsyncWrites(false);
+    Assert(!eeprom.IsBusy(), "Disabling async mode finishes pending write");
+    
+    // Test: A write cycle that outlasts the poll budget fails the write
+    i2c.SetWriteCyclePolls(150);  // Budget is 20 x 5 ms = 100 polls
+    Assert(!eeprom.LogData(12, 26.0f), "Write cycle timeout reported by LogData");
+    Assert(eeprom.IsBusy(), "Timed-out write cycle stays pending");
+    AssertClose(eeprom.ReadData(12), 26.0f, 0.001f, "Next access polls again until the device ACKs");
+    Assert(!eeprom.IsBusy(), "Pending cleared once the device ACKed");
+    i2c.SetWriteCyclePolls(0);
+}
+
+// ============================================================================
+// TEST 12: Delta-Compressed Log
+// ============================================================================
+
+void TestCompressedLog() {
+    TestHeader("TEST 12: Delta-Compressed Log");
+    
+    RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    CompressedLogWriter writer(eeprom);
+    
+    // Slow drift of a few 1/16 C steps with an occasional door-open jump
+    const int SAMPLES = 2000;
+    static int16_t expected[SAMPLES];
+    int16_t value = 22 * 16;
+    for (int i = 0; i < SAMPLES; i++) {
+        int step = (i * 7) % 5 - 2;        // -2..+2
+        if (i % 250 == 0) {
+            step = (i % 500 == 0) ? 40 : -40;  // Out-of-range delta (escape)
+        }
+        value = static_cast<int16_t>(value + step);
+        expected[i] = value;
+        writer.Append(value);
+    }
+    Assert(writer.Flush(), "Flush partial compressed page");
+    
+    uint32_t pagesUsed = writer.GetCurrentPage() + 1;
+    uint32_t writes = i2c.GetEepromDataWrites();
+    float ratio = (float)SAMPLES / (float)pagesUsed / 32.0f;
+    printf("  [*] %d samples in %u pages (%.2fx vs 16-bit samples)\n",
+           SAMPLES, (unsigned int)pagesUsed, ratio);
+    Assert(ratio >= 3.0f, "At least 3x more samples per page than raw format");
+    Assert(writes == pagesUsed, "One write cycle per page (no per-sample traffic)");
+    
+    // Test: Streaming decoder returns every sample in order
+    CompressedLogReader reader(eeprom);
+    int decoded = 0;
+    bool dataOk = true;
+    int16_t sample = 0;
+    while (reader.Next(sample)) {
+        if (decoded >= SAMPLES || sample != expected[decoded]) {
+            dataOk = false;
+        }
+        decoded++;
+    }
+    Assert(decoded == SAMPLES, "Decoder returned all samples");
+    Assert(dataOk, "Decoded samples match logged values");
+    Assert(reader.GetPagesRead() == pagesUsed + 1, "Decoder read one page per transaction");
+    
+    // Test: Extremes survive the escape path
+    RealI2CMock i2c2;
+    EEPROM24FC256 eeprom2(i2c2, 0x50);
+    CompressedLogWriter writer2(eeprom2);
+    writer2.Append(-55.0f);
+    writer2.Append(125.0f);
+    writer2.Append(124.5625f);
+    writer2.Flush();
+    CompressedLogReader reader2(eeprom2);
+    int16_t a = 0, b = 0, c = 0;
+    bool ok = reader2.Next(a) && reader2.Next(b) && reader2.Next(c);
+    Assert(ok && a == -55 * 16 && b == 125 * 16 && c == 1993, "Extreme values round-trip");
+    Assert(!reader2.Next(a), "Decoder stops at erased page");
+    
+    // Test: Ring of 4 pages wraps; the reader follows it and stops at stale pages
+    RealI2CMock i2c3;
+    EEPROM24FC256 eeprom3(i2c3, 0x50);
+    CompressedLogWriter ringWriter(eeprom3, 10, 4);
+    const int PER_PAGE = CompressedLog::MAX_SAMPLES;
+    const int RING_SAMPLES = 5 * PER_PAGE + 50;  // Pages 0..5: the last two overwrite pages 0 and 1
+    for (int i = 0; i < RING_SAMPLES; i++) {
+        ringWriter.Append(static_cast<int16_t>(320 + i % 5));
+    }
+    ringWriter.Flush();
+    Assert(ringWriter.GetCurrentPage() == 11, "Writer wrapped to the second page of the ring");
+    
+    CompressedLogReader fromFirst(eeprom3, 10, 4);
+    int ringCount = 0;
+    while (fromFirst.Next(sample)) {
+        ringCount++;
+    }
+    Assert(ringCount == PER_PAGE + 50 && fromFirst.GetPagesRead() == 3,
+           "Reader from the first page stops at the stale page after the head");
+    
+    CompressedLogReader fromOldest(eeprom3, 10, 4);
+    bool ringOk = fromOldest.SeekOldest();
+    ringCount = 0;
+    while (fromOldest.Next(sample)) {
+        ringOk = ringOk && sample == 320 + (2 * PER_PAGE + ringCount) % 5;
+        ringCount++;
+    }
+    Assert(ringOk && ringCount == 3 * PER_PAGE + 50 && fromOldest.GetPagesRead() == 4,
+           "Reader from the oldest page wraps at the end of the ring");
+    
+    // Test: Writer recovered after a reset continues the sequence on a fresh page
+    CompressedLogWriter resumed(eeprom3, 10, 4);
+    Assert(resumed.Recover() && resumed.GetCurrentPage() == 12, "Recover() opens the page after the head");
+    for (int i = 0; i < 10; i++) {
+        resumed.Append(static_cast<int16_t>(-100 - i));
+    }
+    resumed.Flush();
+    CompressedLogReader afterReset(eeprom3, 10, 4);
+    afterReset.SeekOldest();
+    ringCount = 0;
+    int16_t lastSample = 0;
+    while (afterReset.Next(sample)) {
+        lastSample = sample;
+        ringCount++;
+    }
+    Assert(ringCount == 2 * PER_PAGE + 50 + 10 && lastSample == -109, "Log continues across the reset");
+    
+    // Retention at 10-minute intervals for steady temperatures
+    uint32_t days = (uint32_t)CompressedLog::DEVICE_PAGES * CompressedLog::MAX_SAMPLES * 10 / (24 * 60);
+    printf("  [*] Best-case retention: %u days\n", (unsigned int)days);
+}
+
+// ============================================================================
+// TEST 13: 12-Bit Packed Samples
+// ============================================================================
+
+void TestPacked12() {
+    TestHeader("TEST 13: 12-Bit Packed Samples");
+    
+    RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    
+    // Test: Capacity gain over 16-bit samples
+    Assert(EEPROM24FC256::PACKED12_SAMPLES_PER_PAGE == 42, "42 packed samples per page");
+    Assert(EEPROM24FC256::PACKED12_CAPACITY == 21504, "21,504 packed samples per device");
+    
+    // Test: Full-range values round-trip (TMP100 -55C..+125C and 12-bit limits)
+    int16_t extremes[6] = { -55 * 16, 125 * 16, -1, 0, -2048, 2047 };
+    Assert(eeprom.WritePacked12(0, extremes, 6), "Write 6 packed samples");
+    int16_t back[6] = {0};
+    Assert(eeprom.ReadPacked12(0, back, 6), "Read 6 packed samples");
+    Assert(std::memcmp(back, extremes, sizeof(back)) == 0, "Extreme values round-trip");
+    
+    // Test: Write a whole device worth of samples in one call
+    static int16_t samples[EEPROM24FC256::PACKED12_CAPACITY];
+    for (uint16_t i = 0; i < EEPROM24FC256::PACKED12_CAPACITY; i++) {
+        samples[i] = static_cast<int16_t>((i * 37) % 4096 - 2048);
+    }
+    uint32_t writesBefore = i2c.GetEepromDataWrites();
+    Assert(eeprom.WritePacked12(0, samples, EEPROM24FC256::PACKED12_CAPACITY),
+           "Fill device with packed samples");
+    Assert(i2c.GetEepromDataWrites() - writesBefore == 512, "One page write per page");
+    
+    // Test: Whole-device dump costs 3/4 of the bus bytes of 16-bit samples
+    static int16_t dump[EEPROM24FC256::PACKED12_CAPACITY];
+    uint32_t readsBefore = i2c.GetEepromReads();
+    Assert(eeprom.ReadPacked12(0, dump, EEPROM24FC256::PACKED12_CAPACITY), "Dump all packed samples");
+    Assert(i2c.GetEepromReads() - readsBefore == 1, "Packed dump is one read transaction");
+    Assert(std::memcmp(dump, samples, sizeof(dump)) == 0, "Packed dump matches written samples");
+    
+    // Test: Partial reads at every alignment around page gaps
+    bool rangesOk = true;
+    const uint16_t starts[] = { 0, 1, 39, 40, 41, 42, 83, 21500 };
+    const uint16_t counts[] = { 1, 2, 3, 4, 5, 7, 43, 85 };
+    for (uint16_t start : starts) {
+        for (uint16_t count : counts) {
+            if (start + count > EEPROM24FC256::PACKED12_CAPACITY) {
+                continue;
+            }
+            int16_t part[85];
+            if (!eeprom.ReadPacked12(start, part, count) ||
+                std::memcmp(part, &samples[start], count * sizeof(int16_t)) != 0) {
+                rangesOk = false;
+            }
+        }
+    }
+    Assert(rangesOk, "Partial reads correct at all page alignments");
+    
+    // Test: Single odd/even writes keep the neighbour sharing their byte
+    int16_t one = 100;
+    eeprom.WritePacked12(41, &one, 1);   // Odd slot, last of a page
+    int16_t two[2] = { -300, 5 };
+    eeprom.WritePacked12(43, two, 2);    // Odd slot then even slot
+    int16_t check[5] = {0};
+    eeprom.ReadPacked12(40, check, 5);
+    Assert(check[0] == samples[40] && check[1] == 100, "Odd-slot write preserves even neighbour");
+    Assert(check[2] == samples[42] && check[3] == -300 && check[4] == 5,
+           "Unaligned write preserves neighbours");
+    
+    // Test: Out-of-range requests
+    int16_t big = 2048;
+    Assert(!eeprom.WritePacked12(0, &big, 1), "Value wider than 12 bits rejected");
+    Assert(!eeprom.ReadPacked12(21504, check, 1), "Read past packed capacity rejected");
+}
+
+// ============================================================================
+// TEST 14: Persistent Ring Head and Boot Recovery
+// ============================================================================
+
+void TestLogRingRecovery() {
+    TestHeader("TEST 14: Persistent Ring Head and Boot Recovery");
+    
+    RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    
+    // Test: Blank EEPROM recovers as an empty ring
+    {
+        LogRing ring(eeprom);
+        Assert(ring.Recover(), "Recover on blank EEPROM");
+        Assert(ring.GetHeadPage() == 0 && ring.GetHeadCount() == 0, "Blank EEPROM is an empty ring");
+    }
+    
+    // Log 1000 samples, flushing after each one (brown-out safe)
+    const int SAMPLES = 1000;
+    {
+        LogRing ring(eeprom);
+        ring.Recover();
+        for (int i = 0; i < SAMPLES; i++) {
+            ring.Append(static_cast<int16_t>(i));
+            ring.Flush();
+        }
+    }
+    
+    // Test: After "reset", the head is found with a binary search
+    LogRing ring(eeprom);
+    uint32_t readsBefore = i2c.GetEepromReads();
+    Assert(ring.Recover(), "Recover after reset");
+    uint32_t reads = i2c.GetEepromReads() - readsBefore;
+    printf("  [*] Boot recovery: %u read transactions for %u pages\n",
+           (unsigned int)reads, (unsigned int)LogRing::DEVICE_PAGES);
+    Assert(reads <= 12, "Recovery costs O(log pages) reads");
+    Assert(ring.GetHeadPage() == SAMPLES / LogRing::SAMPLES_PER_PAGE, "Head page recovered");
+    Assert(ring.GetHeadCount() == SAMPLES % LogRing::SAMPLES_PER_PAGE, "Head page fill recovered");
+    
+    // Test: Logging continues where it stopped, nothing overwritten
+    ring.Append(static_cast<int16_t>(SAMPLES));
+    ring.Flush();
+    int16_t page[LogRing::SAMPLES_PER_PAGE];
+    uint8_t count = 0;
+    bool dataOk = true;
+    int expected = 0;
+    for (uint16_t age = 0; age < ring.GetUsedPages(); age++) {
+        ring.ReadPage(age, page, count);
+        for (uint8_t i = 0; i < count; i++) {
+            if (page[i] != expected++) {
+                dataOk = false;
+            }
+        }
+    }
+    Assert(dataOk && expected == SAMPLES + 1, "All samples intact and in order after recovery");
+    
+    // Test: Wrapped ring (4 pages) recovers head and oldest page
+    RealI2CMock i2c2;
+    EEPROM24FC256 eeprom2(i2c2, 0x50);
+    {
+        LogRing small(eeprom2, 10, 4);
+        small.Recover();
+        for (int i = 0; i < 4 * LogRing::SAMPLES_PER_PAGE + 5; i++) {
+            small.Append(static_cast<int16_t>(i));
+        }
+        small.Flush();
+    }
+    LogRing small(eeprom2, 10, 4);
+    Assert(small.Recover(), "Recover wrapped ring");
+    Assert(small.GetHeadPage() == 0 && small.GetSequence() == 4, "Wrapped head at page 0, sequence 4");
+    Assert(small.GetHeadCount() == 5, "Wrapped head page fill recovered");
+    Assert(small.GetUsedPages() == 4, "Wrapped ring reports all pages used");
+    small.ReadPage(0, page, count);
+    Assert(count == LogRing::SAMPLES_PER_PAGE && page[0] == LogRing::SAMPLES_PER_PAGE,
+           "Oldest page follows the head");
+    
+    // Test: Full head page at reset opens the next page on recovery
+    {
+        LogRing full(eeprom2, 10, 4);
+        full.Recover();
+        for (int i = 0; i < LogRing::SAMPLES_PER_PAGE - 5; i++) {
+            full.Append(static_cast<int16_t>(1000 + i));
+        }
+    }
+    LogRing full(eeprom2, 10, 4);
+    full.Recover();
+    Assert(full.GetHeadPage() == 1 && full.GetHeadCount() == 0, "Full head page advances on recovery");
+}
+
+// ============================================================================
+// TEST 15: Time-Indexed Range Queries
+// ============================================================================
+
+void TestTimeIndexedQuery() {
+    TestHeader("TEST 15: Time-Indexed Range Queries");
+    
+    RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    LogRing ring(eeprom);
+    ring.Recover();
+    
+    // 2000 samples every 600 s; a 1-hour outage after sample 1000
+    const int SAMPLES = 2000;
+    static uint32_t sampleTime[SAMPLES];
+    uint32_t t = 600;
+    for (int i = 0; i < SAMPLES; i++) {
+        if (i == 1000) {
+            t += 3600;
+        }
+        sampleTime[i] = t;
+        ring.Append(static_cast<int16_t>(i % 300), t);
+        t += 600;
+    }
+    ring.Flush();
+    
+    LogRing::PageInfo info;
+    Assert(ring.ReadPageInfo(0, info), "Read page header");
+    Assert(info.baseTime == 600 && info.interval == 600 && info.count == LogRing::SAMPLES_PER_PAGE,
+           "Header holds base time and interval");
+    Assert(info.minValue == 0 && info.maxValue == LogRing::SAMPLES_PER_PAGE - 1,
+           "Header holds min/max summary");
+    
+    // Test: Range query returns exactly the samples inside [t1, t2]
+    const int FIRST = 1500, LAST = 1599;
+    int16_t out[200];
+    uint32_t times[200];
+    uint32_t readsBefore = i2c.GetEepromReads();
+    uint16_t n = ring.Query(sampleTime[FIRST], sampleTime[LAST], out, 200, times);
+    uint32_t reads = i2c.GetEepromReads() - readsBefore;
+    
+    bool dataOk = (n == LAST - FIRST + 1);
+    for (int i = 0; dataOk && i < n; i++) {
+        dataOk = (out[i] == (FIRST + i) % 300) && (times[i] == sampleTime[FIRST + i]);
+    }
+    Assert(dataOk, "Query returned the 100 samples in range with timestamps");
+    printf("  [*] 100-sample query: %u read transactions (log spans %u pages)\n",
+           (unsigned int)reads, (unsigned int)ring.GetUsedPages());
+    Assert(reads <= 10 + 6, "Query cost ~log(pages) + pages in range");
+    
+    // Test: Cadence break (outage) starts a new page with exact times
+    n = ring.Query(sampleTime[995], sampleTime[1005], out, 200, times);
+    Assert(n == 11 && times[5] == sampleTime[1000] && times[4] == sampleTime[999],
+           "Samples around an outage keep exact timestamps");
+    
+    // Test: Ranges outside the log
+    Assert(ring.Query(0, 599, out, 200) == 0, "Range before first sample is empty");
+    Assert(ring.Query(t, t + 6000, out, 200) == 0, "Range after last sample is empty");
+    Assert(ring.Query(sampleTime[0], sampleTime[9], out, 5) == 5, "Query stops at maxCount");
+    
+    // Test: Min/max from headers matches brute force
+    int16_t minV = 0, maxV = 0;
+    bool ok = ring.QueryMinMax(sampleTime[250], sampleTime[1290], minV, maxV);
+    Assert(ok && minV == 0 && maxV == 299, "Min/max over a long range");
+    ok = ring.QueryMinMax(sampleTime[310], sampleTime[320], minV, maxV);
+    Assert(ok && minV == 10 && maxV == 20, "Min/max inside one page");
+    Assert(!ring.QueryMinMax(0, 100, minV, maxV), "Min/max of empty range reports no data");
+    
+    // Test: Out-of-order samples are rejected so page base times stay sorted
+    uint32_t newest = sampleTime[SAMPLES - 1];
+    uint16_t headCount = ring.GetHeadCount();
+    Assert(!ring.Append(static_cast<int16_t>(-5), newest - 600) && ring.GetHeadCount() == headCount &&
+           ring.GetLastTime() == newest, "Sample older than the newest one is rejected");
+    Assert(ring.Append(static_cast<int16_t>(-6), newest) && ring.GetLastTime() == newest,
+           "Sample at the same time is accepted");
+    ring.Flush();
+    Assert(ring.Query(sampleTime[1500], sampleTime[1599], out, 200) == 100 &&
+           ring.Query(newest, newest, out, 200) == 2 && out[1] == -6, "Queries still find every range");
+    LogRing rebooted(eeprom);
+    Assert(rebooted.Recover() && rebooted.GetLastTime() == newest &&
+           !rebooted.Append(static_cast<int16_t>(0), 600), "Recover() restores the newest timestamp");
+}
+
+// ============================================================================
+// TEST 16: Multi-Device Striped Volume
+// ============================================================================
+
+void TestStripedVolume() {
+    TestHeader("TEST 16: Multi-Device Striped Volume");
+    
+    // Each write cycle lasts 4 bus transactions
+    static MultiEEPROMMock bus(4);
+    EEPROM24FC256 dev0(bus, 0x50), dev1(bus, 0x51), dev2(bus, 0x52), dev3(bus, 0x53);
+    EEPROM24FC256* devices[4] = { &dev0, &dev1, &dev2, &dev3 };
+    EEPROMVolume volume(devices, 4);
+    volume.SetAsyncWrites(true);
+    
+    Assert(volume.GetCapacity() == 4u * 32768u, "4-device volume is 128 KB");
+    
+    // Test: Consecutive pages land on consecutive devices
+    uint8_t page[64];
+    for (uint32_t p = 0; p < 64; p++) {
+        std::memset(page, (uint8_t)p, sizeof(page));
+        volume.WritePage(p * 64, page, sizeof(page));
+    }
+    volume.Poll();
+    Assert(bus.GetMemory(0)[0] == 0 && bus.GetMemory(1)[0] == 1 &&
+           bus.GetMemory(3)[0] == 3 && bus.GetMemory(0)[64] == 4,
+           "Pages interleaved across devices");
+    
+    // Test: Write cycles overlap - no device was waited on
+    Assert(bus.GetNacks() == 0, "Striped writes never waited for a write cycle");
+    
+    // Same 64 pages on a single device must wait out every write cycle
+    static MultiEEPROMMock single(4);
+    EEPROM24FC256 only(single, 0x50);
+    only.SetAsyncWrites(true);
+    for (uint16_t p = 0; p < 64; p++) {
+        only.WritePage(p * 64, page, sizeof(page));
+    }
+    printf("  [*] 64 page writes: %u busy polls on 1 device, %u on 4 striped devices\n",
+           (unsigned int)single.GetNacks(), (unsigned int)bus.GetNacks());
+    Assert(single.GetNacks() > 0, "Single device waits for each write cycle");
+    
+    // Test: Reads and writes spanning devices
+    uint8_t data[200];
+    for (int i = 0; i < 200; i++) {
+        data[i] = (uint8_t)(i * 3);
+    }
+    uint32_t base = 3 * 32768 + 100;  // Unaligned, pages on all four devices
+    bool ok = volume.WritePage(base, data, 28) &&
+              volume.WritePage(base + 28, data + 28, 64) &&
+              volume.WritePage(base + 92, data + 92, 64) &&
+              volume.WritePage(base + 156, data + 156, 44);
+    Assert(ok, "Write 200 bytes page by page");
+    uint8_t back[200] = {0};
+    Assert(volume.ReadBytes(base, back, 200), "Read 200 bytes across devices");
+    Assert(std::memcmp(back, data, 200) == 0, "Cross-device data intact");
+    
+    // Test: Range checks
+    Assert(!volume.WritePage(60, data, 8), "Write crossing a page rejected");
+    Assert(!volume.ReadBytes(4u * 32768u - 1, back, 2), "Read past volume end rejected");
+}
+
+// ============================================================================
+// TEST 17: EEPROM Geometry Template
+// ============================================================================
+
+/// Records the last write so the address bytes on the wire can be checked
+class CaptureI2C : public II2CController {
+public:
+    uint8_t lastWrite[160] = {0};
+    size_t lastWriteLen = 0;
+    
+    I2CStatus Write(uint8_t, const uint8_t* data, size_t len) override {
+        lastWriteLen = len;
+        for (size_t i = 0; i < len && i < sizeof(lastWrite); i++) {
+            lastWrite[i] = data[i];
+        }
+        return I2CStatus::OK;
+    }
+    
+    I2CStatus Read(uint8_t, uint8_t* buffer, size_t len) override {
+        std::memset(buffer, 0, len);
+        return I2CStatus::OK;
+    }
+};
+
+void TestEEPROMGeometry() {
+    TestHeader("TEST 17: EEPROM Geometry Template");
+    
+    // Test: Geometry constants derived at compile time
+    Assert(EEPROM24LC64::PAGE_SIZE == 32 && EEPROM24LC64::PAGE_SHIFT == 5 &&
+           EEPROM24LC64::PAGE_COUNT == 256, "24LC64: 256 pages of 32 bytes");
+    Assert(EEPROM24FC256::PAGE_SHIFT == 6 && EEPROM24FC256::PAGE_MASK == 0x3F &&
+           EEPROM24FC256::PAGE_COUNT == 512, "24FC256: 512 pages of 64 bytes");
+    Assert(EEPROM24FC512::PAGE_SIZE == 128 && EEPROM24FC512::PAGE_COUNT == 512,
+           "24FC512: 512 pages of 128 bytes");
+    Assert(EEPROM24LC64::PACKED12_SAMPLES_PER_PAGE == 20 &&
+           EEPROM24FC512::PACKED12_SAMPLES_PER_PAGE == 84,
+           "Packed 12-bit layout scales with page size");
+    
+    // Test: 24LC64 page and capacity limits
+    static RealI2CMock mock;
+    EEPROM24LC64 small(mock, 0x50);
+    uint8_t data[128];
+    for (int i = 0; i < 128; i++) {
+        data[i] = (uint8_t)(i + 1);
+    }
+    Assert(!small.WritePage(30, data, 4), "24LC64 rejects write across a 32-byte page");
+    Assert(small.WritePage(32, data, 32), "24LC64 accepts a full 32-byte page");
+    Assert(small.WritePage(8190, data, 2), "24LC64 accepts the last two bytes");
+    Assert(!small.WritePage(8192, data, 2), "24LC64 rejects writes past 8 KB");
+    uint8_t back[128] = {0};
+    Assert(small.ReadBytes(32, back, 32) && std::memcmp(back, data, 32) == 0,
+           "24LC64 page reads back");
+    
+    // Test: 24FC512 writes 128 bytes in one transaction
+    EEPROM24FC512 large(mock, 0x50);
+    uint32_t writesBefore = mock.GetEepromDataWrites();
+    uint32_t bytesBefore = mock.GetEepromBusBytes();
+    Assert(large.WritePage(256, data, 128), "24FC512 accepts a full 128-byte page");
+    Assert(mock.GetEepromDataWrites() - writesBefore == 1 &&
+           mock.GetEepromBusBytes() - bytesBefore == 130,
+           "128-byte page costs one 130-byte transaction");
+    Assert(!large.WritePage(192, data, 128), "24FC512 rejects write across a 128-byte page");
+    Assert(large.ReadBytes(256, back, 128) && std::memcmp(back, data, 128) == 0,
+           "24FC512 page reads back");
+    
+    // Test: 1-byte addressed part sends a single address byte
+    CaptureI2C capture;
+    EEPROM24xx<256, 8, 1, 5> tiny(capture, 0x50);
+    tiny.SetAsyncWrites(true);  // Keep the ACK poll from replacing the capture
+    Assert(tiny.WritePage(0x48, data, 8), "1-byte addressed part accepts a page");
+    Assert(capture.lastWriteLen == 9 && capture.lastWrite[0] == 0x48 &&
+           capture.lastWrite[1] == data[0], "Write is [addr][data], no high address byte");
+    Assert(!tiny.WritePage(0xFC, data, 8), "1-byte addressed part rejects write across a page");
+}
+
+// ============================================================================
+// TEST 18: Hourly and Daily Rollups
+// ============================================================================
+
+void TestRollupLog() {
+    TestHeader("TEST 18: Hourly and Daily Rollups");
+    
+    static RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    
+    // 40 days at 10-minute cadence: the 33-day raw ring wraps.
+    // Sample k of hour h is h*16 + k (k = 0..5): mean h*16 + 2.5 -> rounds to +3
+    const uint32_t DAYS = 40;
+    const uint32_t SAMPLES = DAYS * 24 * 6;
+    {
+        RollupLog log(eeprom);
+        Assert(log.Recover(), "Recover on blank EEPROM");
+        bool ok = true;
+        for (uint32_t i = 0; i < SAMPLES; i++) {
+            uint32_t hour = i / 6;
+            int16_t value = static_cast<int16_t>((hour % 100) * 16 + (i % 6));
+            ok = log.Append(value, i * 600) && ok;
+        }
+        Assert(ok, "40 days logged to all tiers");
+        Assert(log.Flush(), "Flush open hour and day");
+    }
+    
+    // "Reset": recover the raw head and the open hour/day
+    RollupLog log(eeprom);
+    Assert(log.Recover(), "Recover after reset");
+    
+    // Test: Raw ring has wrapped, day 0 samples are gone
+    int16_t samples[8];
+    Assert(log.GetRaw().Query(0, 3599, samples, 8) == 0, "Raw samples of day 0 overwritten");
+    
+    // Test: Daily rollups still cover day 0
+    RollupLog::Record days[DAYS];
+    uint32_t readsBefore = i2c.GetEepromReads();
+    uint16_t n = log.Query(RollupLog::Tier::Daily, 0, SAMPLES * 600 - 1, days, DAYS);
+    uint32_t reads = i2c.GetEepromReads() - readsBefore;
+    Assert(n == DAYS, "One daily record per day");
+    Assert(reads <= 2, "Daily query costs at most two read transactions");
+    Assert(days[0].period == 0 && days[0].minValue == 0 && days[0].maxValue == 23 * 16 + 5,
+           "Day 0 min/max from rollup");
+    printf("  [*] %u days answered from %u bytes in %u read(s)\n",
+           (unsigned int)n, (unsigned int)(n * RollupLog::RECORD_SIZE), (unsigned int)reads);
+    
+    // Test: Hourly means in fixed point
+    RollupLog::Record hours[24];
+    uint32_t lastDay = (DAYS - 1) * RollupLog::DAY_SECONDS;
+    n = log.Query(RollupLog::Tier::Hourly, lastDay, lastDay + RollupLog::DAY_SECONDS - 1, hours, 24);
+    Assert(n == 24, "24 hourly records for the last day");
+    uint32_t firstHour = (DAYS - 1) * 24;
+    bool hoursOk = true;
+    for (uint16_t h = 0; h < n; h++) {
+        int16_t base = static_cast<int16_t>(((firstHour + h) % 100) * 16);
+        hoursOk = hoursOk && hours[h].minValue == base && hours[h].maxValue == base + 5 &&
+                  hours[h].meanValue == base + 3;
+    }
+    Assert(hoursOk, "Hourly min/mean/max match the samples");
+    
+    // Test: Open period rebuilt from raw samples after reset
+    Assert(hours[23].meanValue == static_cast<int16_t>(((firstHour + 23) % 100) * 16 + 3),
+           "Last hour recovered across reset");
+    
+    // Test: Logging continues into a new day after recovery
+    uint32_t t = SAMPLES * 600;
+    Assert(log.Append(static_cast<int16_t>(-160), t), "Append after recovery");
+    n = log.Query(RollupLog::Tier::Daily, t, t, days, 1);
+    Assert(n == 1 && days[0].minValue == -160 && days[0].meanValue == -160,
+           "New day opened from RAM");
+    
+    // Test: Hourly tier outlives the raw ring
+    n = log.Query(RollupLog::Tier::Hourly, 0, 3599, hours, 24);
+    Assert(n == 1 && hours[0].minValue == 0 && hours[0].maxValue == 5,
+           "Hour 0 still answered from the hourly tier");
+    
+    // Test: Periods never logged are not reported
+    n = log.Query(RollupLog::Tier::Hourly, t + RollupLog::DAY_SECONDS, t + 2 * RollupLog::DAY_SECONDS, hours, 24);
+    Assert(n == 0, "Future hours have no records");
+    
+    // Test: Reset mid-hour with only the raw ring flushed; the hour's record
+    // is still written when the hour closes after recovery
+    static RealI2CMock i2c2;
+    EEPROM24FC256 eeprom2(i2c2, 0x50);
+    {
+        RollupLog before(eeprom2);
+        before.Recover();
+        for (uint32_t i = 0; i < 3; i++) {
+            before.Append(static_cast<int16_t>(100 + i), 7200 + i * 600);
+        }
+        before.GetRaw().Flush();
+    }
+    RollupLog after(eeprom2);
+    Assert(after.Recover() && after.Append(static_cast<int16_t>(200), 3 * 3600) && after.Flush(),
+           "Next hour after recovery");
+    RollupLog reread(eeprom2);
+    reread.Recover();
+    n = reread.Query(RollupLog::Tier::Hourly, 7200, 7200 + 3599, hours, 24);
+    Assert(n == 1 && hours[0].minValue == 100 && hours[0].maxValue == 102 && hours[0].meanValue == 101,
+           "Recovered open hour written when it closes");
+    
+    // Test: A timer restarted by the reset continues from the recovered time base
+    MockTimer timer;
+    timer.AdvanceTime(1200);
+    uint32_t timeBase = reread.GetLastTime();
+    Assert(timeBase == 3 * 3600, "Time base is the newest recovered sample");
+    Assert(!reread.Append(static_cast<int16_t>(300), timer.GetElapsedSeconds()),
+           "Raw restarted time rejected (would go backwards)");
+    Assert(reread.Append(static_cast<int16_t>(300), timeBase + timer.GetElapsedSeconds()) && reread.Flush(),
+           "Offset time accepted");
+    int16_t raw[4];
+    uint32_t rawTimes[4];
+    n = reread.GetRaw().Query(3 * 3600, 4 * 3600, raw, 4, rawTimes);
+    Assert(n == 2 && raw[0] == 200 && raw[1] == 300 && rawTimes[1] == 3 * 3600 + 1200,
+           "Samples stay in time order across the reset");
+}
+
+// ============================================================================
+// TEST 19: Page Read Cache
+// ============================================================================
+
+void TestReadCache() {
+    TestHeader("TEST 19: Page Read Cache");
+    
+    static RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    for (uint16_t i = 0; i < 32; i++) {
+        eeprom.LogData(static_cast<uint16_t>(128 + i * 2), 10.0f + i * 0.5f);
+    }
+    
+    // Test: Uncached neighbouring reads cost one transaction each
+    uint32_t readsBefore = i2c.GetEepromReads();
+    for (uint16_t i = 0; i < 32; i++) {
+        eeprom.ReadData(static_cast<uint16_t>(128 + i * 2));
+    }
+    uint32_t uncached = i2c.GetEepromReads() - readsBefore;
+    Assert(uncached == 32, "Without cache: one transaction per ReadData");
+    
+    // Test: Cached reads of one page cost one transaction
+    EEPROM24FC256::CacheLine lines[2];
+    eeprom.AttachReadCache(lines, 2);
+    readsBefore = i2c.GetEepromReads();
+    bool valuesOk = true;
+    for (uint16_t i = 0; i < 32; i++) {
+        float value = eeprom.ReadData(static_cast<uint16_t>(128 + i * 2));
+        valuesOk = valuesOk && std::fabs(value - (10.0f + i * 0.5f)) < 0.07f;
+    }
+    uint32_t cached = i2c.GetEepromReads() - readsBefore;
+    printf("  [*] 32 neighbouring reads: %u transactions uncached, %u cached\n",
+           (unsigned int)uncached, (unsigned int)cached);
+    Assert(valuesOk, "Cached values match EEPROM");
+    Assert(cached == 1, "With cache: one page fetch serves the whole page");
+    Assert(eeprom.GetCacheHits() == 31 && eeprom.GetCacheMisses() == 1, "31 hits, 1 miss");
+    
+    // Test: Write-through keeps the cache coherent without a re-read
+    readsBefore = i2c.GetEepromReads();
+    Assert(eeprom.LogData(140, -12.5f), "LogData into a cached page");
+    AssertClose(eeprom.ReadData(140), -12.5f, 0.07f, "Cached page sees the new value");
+    Assert(i2c.GetEepromReads() == readsBefore, "No read transaction after write-through");
+    
+    // Test: Round-robin replacement across pages
+    eeprom.ResetCacheStats();
+    eeprom.ReadData(0);      // Miss -> line 1
+    eeprom.ReadData(130);    // Hit  (page 2 still in line 0)
+    eeprom.ReadData(256);    // Miss -> replaces page 2
+    eeprom.ReadData(130);    // Miss
+    Assert(eeprom.GetCacheHits() == 1 && eeprom.GetCacheMisses() == 3,
+           "Two lines: third page evicts the oldest");
+    
+    // Test: Reads spanning pages bypass the cache
+    uint8_t buf[100];
+    eeprom.ResetCacheStats();
+    Assert(eeprom.ReadBytes(100, buf, sizeof(buf)), "Multi-page read succeeds");
+    Assert(eeprom.GetCacheHits() == 0 && eeprom.GetCacheMisses() == 0, "Multi-page read bypasses cache");
+    
+    // Test: Detaching restores direct reads
+    eeprom.AttachReadCache(nullptr, 0);
+    readsBefore = i2c.GetEepromReads();
+    eeprom.ReadData(130);
+    eeprom.ReadData(130);
+    Assert(i2c.GetEepromReads() - readsBefore == 2, "Detached cache: direct reads");
+}
+
+// ============================================================================
+// TEST 20: TMP100 One-Shot Conversions
+// ============================================================================
+
+void TestOneShotConversion() {
+    TestHeader("TEST 20: TMP100 One-Shot Conversions");
+    
+    RealI2CMock i2c;
+    TMP100 sensor(i2c, 0x48);
+    
+    // Test: One-shot init shuts the sensor down
+    i2c.SetSimulatedTemperature(21.0f);
+    Assert(sensor.Init(TMP100::ConversionMode::OneShot), "One-shot initialization");
+    Assert(sensor.GetConversionMode() == TMP100::ConversionMode::OneShot, "Mode reported as one-shot");
+    Assert(i2c.GetTmp100Config() == 0x61, "Config = 12-bit, SD set");
+    
+    // Test: Datasheet maximum conversion time per resolution
+    Assert(sensor.GetConversionTimeMs() == 600, "12-bit conversion takes up to 600 ms");
+    TMP100 fast(i2c, 0x48);
+    fast.Init(TMP100::ConversionMode::OneShot, TMP100::Resolution::Bits_9);
+    Assert(fast.GetConversionTimeMs() == 75, "9-bit conversion takes up to 75 ms");
+    sensor.Init(TMP100::ConversionMode::OneShot);
+    
+    // Test: Shut down sensor holds its last result until triggered
+    i2c.SetSimulatedTemperature(30.0f);
+    AssertClose(sensor.ReadTemperature(), 21.0f, 0.1f, "No conversion without a trigger");
+    
+    // Test: StartConversion runs exactly one conversion
+    Assert(sensor.StartConversion(), "Trigger one-shot conversion");
+    Assert(i2c.GetTmp100Conversions() == 1, "One conversion triggered");
+    Assert(i2c.GetTmp100Config() == 0x61, "Sensor back in shutdown after one-shot");
+    AssertClose(sensor.ReadTemperature(), 30.0f, 0.1f, "Result of the one-shot conversion");
+    
+    // Test: Continuous mode needs no trigger and sends nothing
+    TMP100 continuous(i2c, 0x48);
+    continuous.Init();
+    uint32_t writesBefore = i2c.GetTmp100Writes();
+    Assert(continuous.StartConversion(), "StartConversion in continuous mode");
+    Assert(i2c.GetTmp100Writes() == writesBefore, "No bus traffic in continuous mode");
+    Assert(continuous.GetConversionMode() == TMP100::ConversionMode::Continuous,
+           "Mode reported as continuous");
+}
+
+// ============================================================================
+// TEST 21: TMP100 Runtime Resolution and Burst Profile
+// ============================================================================
+
+void TestResolutionProfiles() {
+    TestHeader("TEST 21: TMP100 Runtime Resolution and Burst Profile");
+    
+    RealI2CMock i2c;
+    TMP100 sensor(i2c, 0x48);
+    sensor.Init();
+    i2c.SetSimulatedTemperature(22.3125f);
+    
+    // Test: 12-bit default
+    Assert(sensor.GetResolution() == TMP100::Resolution::Bits_12 && sensor.GetLsbQ4() == 1,
+           "Default 12-bit, LSB 1/16 C");
+    AssertClose(sensor.ReadTemperature(), 22.3125f, 0.001f, "12-bit reading keeps 1/16 C");
+    
+    // Test: Switch to 10 bits at runtime
+    Assert(sensor.SetResolution(TMP100::Resolution::Bits_10), "Switch to 10-bit");
+    Assert(i2c.GetTmp100Config() == 0x20, "Config register holds 10-bit continuous");
+    Assert(sensor.GetConversionTimeMs() == 150 && sensor.GetLsbQ4() == 4,
+           "10-bit: 150 ms, LSB 1/4 C");
+    AssertClose(sensor.ReadTemperature(), 22.25f, 0.001f, "10-bit reading quantized to 1/4 C");
+    
+    // Test: Unchanged resolution costs no bus transaction
+    uint32_t writesBefore = i2c.GetTmp100Writes();
+    sensor.SetResolution(TMP100::Resolution::Bits_10);
+    Assert(i2c.GetTmp100Writes() == writesBefore, "Same resolution: no write");
+    
+    // Test: Resolution change keeps one-shot mode
+    TMP100 oneShot(i2c, 0x48);
+    oneShot.Init(TMP100::ConversionMode::OneShot);
+    oneShot.SetResolution(TMP100::Resolution::Bits_11);
+    Assert(i2c.GetTmp100Config() == 0x41 &&
+           oneShot.GetConversionMode() == TMP100::ConversionMode::OneShot,
+           "11-bit, still shut down");
+    
+    // Test: Burst profile drops to 9-bit continuous and restores afterwards
+    Assert(oneShot.BeginBurst(), "Begin burst");
+    Assert(oneShot.IsBursting() && i2c.GetTmp100Config() == 0x00, "Burst: 9-bit continuous");
+    Assert(oneShot.GetConversionTimeMs() == 75 && oneShot.GetLsbQ4() == 8, "Burst: 75 ms, LSB 1/2 C");
+    AssertClose(oneShot.ReadTemperature(), 22.0f, 0.001f, "Burst reading quantized to 1/2 C");
+    printf("  [*] Max sample rate: %.1f/s at 9 bits vs %.1f/s at 12 bits\n",
+           1000.0f / 75.0f, 1000.0f / 600.0f);
+    Assert(oneShot.EndBurst(), "End burst");
+    Assert(!oneShot.IsBursting() && i2c.GetTmp100Config() == 0x41, "Previous configuration restored");
+}
+
+// ============================================================================
+// TEST 22: TMP100 Thermostat Thresholds and Alerts
+// ============================================================================
+
+void TestThresholdAlerts() {
+    TestHeader("TEST 22: TMP100 Thermostat Thresholds and Alerts");
+    
+    RealI2CMock i2c;
+    TMP100 sensor(i2c, 0x48);
+    sensor.Init();
+    i2c.SetSimulatedTemperature(22.0f);
+    
+    // Test: Thresholds programmed left-justified like the temperature register
+    Assert(sensor.SetThresholds(18.0f, 27.0f), "Program 18-27C band");
+    Assert(i2c.GetTmp100Limit(0) == 0x1200 && i2c.GetTmp100Limit(1) == 0x1B00,
+           "TLOW = 0x1200, THIGH = 0x1B00");
+    Assert(!sensor.SetThresholds(30.0f, 20.0f), "Inverted band rejected");
+    
+    // Test: Comparator mode with a fault queue of 2
+    Assert(sensor.ConfigureAlert(TMP100::AlertMode::Comparator, TMP100::FaultQueue::Faults_2),
+           "Comparator mode, 2 faults");
+    Assert((i2c.GetTmp100Config() & 0x7E) == 0x68, "Resolution kept, TM = 0, F = 01");
+    bool active = true;
+    Assert(sensor.ReadAlert(active) && !active, "In band: no alert");
+    
+    i2c.SetSimulatedTemperature(28.0f);
+    sensor.ReadAlert(active);
+    Assert(!active, "One conversion above THIGH filtered by fault queue");
+    i2c.SetSimulatedTemperature(28.5f);
+    sensor.ReadAlert(active);
+    Assert(active, "Second conversion above THIGH raises alert");
+    
+    i2c.SetSimulatedTemperature(25.0f);
+    i2c.SetSimulatedTemperature(25.0f);
+    sensor.ReadAlert(active);
+    Assert(active, "Comparator holds alert until below TLOW (hysteresis)");
+    
+    i2c.SetSimulatedTemperature(17.0f);
+    i2c.SetSimulatedTemperature(17.0f);
+    sensor.ReadAlert(active);
+    Assert(!active, "Alert clears below TLOW");
+    
+    // Test: Interrupt mode latches one event per crossing
+    sensor.ConfigureAlert(TMP100::AlertMode::Interrupt);
+    i2c.SetSimulatedTemperature(22.0f);
+    sensor.ReadAlert(active);
+    Assert(!active, "Interrupt mode: no event in band");
+    i2c.SetSimulatedTemperature(28.0f);
+    sensor.ReadAlert(active);
+    Assert(active, "Interrupt mode: THIGH crossing reported");
+    sensor.ReadAlert(active);
+    Assert(!active, "Interrupt mode: event cleared by the read");
+    i2c.SetSimulatedTemperature(29.0f);
+    sensor.ReadAlert(active);
+    Assert(!active, "Still above THIGH: no repeated event");
+    i2c.SetSimulatedTemperature(17.0f);
+    sensor.ReadAlert(active);
+    Assert(active, "Interrupt mode: return below TLOW reported");
+}
+
+// ============================================================================
+// TEST 23: TMP100 Pointer Register Caching
+// ============================================================================
+
+/// Forwards to another bus, failing a chosen number of transactions
+class FlakyI2C : public II2CController {
+public:
+    explicit FlakyI2C(II2CController& bus) : m_bus(bus) {}
+    
+    /// Fail the next n transactions with status (NACK by default)
+    void FailNext(uint32_t n, I2CStatus status = I2CStatus::Nack) {
+        m_failures = n;
+        m_failStatus = status;
+    }
+    
+    /// Transactions that reached this bus (failed ones included)
+    uint32_t GetAttempts() const { return m_attempts; }
+    
+    I2CStatus Write(uint8_t addr, const uint8_t* data, size_t len) override {
+        m_attempts++;
+        if (m_failures > 0) {
+            m_failures--;
+            return m_failStatus;
+        }
+        return m_bus.Write(addr, data, len);
+    }
+    
+    I2CStatus Read(uint8_t addr, uint8_t* buffer, size_t len) override {
+        m_attempts++;
+        if (m_failures > 0) {
+            m_failures--;
+            return m_failStatus;
+        }
+        return m_bus.Read(addr, buffer, len);
+    }
+    
+private:
+    II2CController& m_bus;
+    uint32_t m_failures = 0;
+    I2CStatus m_failStatus = I2CStatus::Nack;
+    uint32_t m_attempts = 0;
+};
+
+void TestPointerCaching() {
+    TestHeader("TEST 23: TMP100 Pointer Register Caching");
+    
+    RealI2CMock i2c;
+    FlakyI2C bus(i2c);
+    TMP100 sensor(bus, 0x48);
+    sensor.Init();
+    sensor.SetThresholds(18.0f, 27.0f);
+    i2c.SetSimulatedTemperature(23.5f);
+    
+    // Test: First read selects the temperature register
+    uint32_t writes = i2c.GetTmp100Writes();
+    uint32_t reads = i2c.GetTmp100Reads();
+    AssertClose(sensor.ReadTemperature(), 23.5f, 0.01f, "First read correct");
+    Assert(i2c.GetTmp100Writes() - writes == 1 && i2c.GetTmp100Reads() - reads == 1,
+           "First read: pointer write + read");
+    
+    // Test: Following reads are a single bare read each
+    writes = i2c.GetTmp100Writes();
+    reads = i2c.GetTmp100Reads();
+    bool valuesOk = true;
+    for (int i = 0; i < 10; i++) {
+        valuesOk = valuesOk && std::fabs(sensor.ReadTemperature() - 23.5f) < 0.01f;
+    }
+    printf("  [*] 10 reads: %u pointer writes, %u reads\n",
+           (unsigned int)(i2c.GetTmp100Writes() - writes), (unsigned int)(i2c.GetTmp100Reads() - reads));
+    Assert(valuesOk, "Cached-pointer reads correct");
+    Assert(i2c.GetTmp100Writes() == writes && i2c.GetTmp100Reads() - reads == 10,
+           "10 reads, no pointer writes");
+    
+    // Test: Config and threshold writes move the pointer
+    sensor.SetResolution(TMP100::Resolution::Bits_11);
+    writes = i2c.GetTmp100Writes();
+    AssertClose(sensor.ReadTemperature(), 23.5f, 0.01f, "Read after config write");
+    Assert(i2c.GetTmp100Writes() - writes == 1, "Pointer rewritten after config write");
+    
+    sensor.SetThresholds(10.0f, 30.0f);
+    writes = i2c.GetTmp100Writes();
+    sensor.ReadTemperature();
+    Assert(i2c.GetTmp100Writes() - writes == 1, "Pointer rewritten after threshold write");
+    
+    // Test: Alert reads select the config register, then temperature again
+    bool active = false;
+    sensor.ReadAlert(active);
+    writes = i2c.GetTmp100Writes();
+    sensor.ReadAlert(active);
+    Assert(i2c.GetTmp100Writes() == writes, "Repeated alert reads: bare reads");
+    sensor.ReadTemperature();
+    Assert(i2c.GetTmp100Writes() - writes == 1, "Temperature read reselects its register");
+    
+    // Test: A failed transaction invalidates the cache
+    bus.FailNext(1);
+    Assert(sensor.ReadTemperature() < -900.0f, "Failed read reports error");
+    writes = i2c.GetTmp100Writes();
+    AssertClose(sensor.ReadTemperature(), 23.5f, 0.01f, "Read after error correct");
+    Assert(i2c.GetTmp100Writes() - writes == 1, "Pointer rewritten after error");
+}
+
+// ============================================================================
+// TEST 24: Multi-Sensor TMP100 Array
+// ============================================================================
+
+/// Eight TMP100s at 0x48-0x4F (pointer, config and temperature registers)
+class MultiTMP100Mock final : public II2CController {
+public:
+    MultiTMP100Mock() {
+        for (uint8_t i = 0; i < 8; i++) {
+            m_tempQ4[i] = (int16_t)(320 + i * 8);  // 20.0C + 0.5C per sensor
+        }
+    }
+    
+    /// Sensors that acknowledge (bit i = address 0x48 + i)
+    void SetPresent(uint8_t mask) { m_present = mask; }
+    
+    void SetTemperatureQ4(uint8_t index, int16_t q4) { m_tempQ4[index] = q4; }
+    
+    I2CStatus Write(uint8_t addr, const uint8_t* data, size_t len) override {
+        int dev = Device(addr);
+        if (dev < 0) return I2CStatus::Nack;
+        m_transactions++;
+        if (len >= 1) {
+            m_pointer[dev] = data[0] & 0x03;
+            if (len == 1) m_pointerWrites++;
+        }
+        if (len >= 2 && m_pointer[dev] == 0x01) {
+            m_config[dev] = data[1] & 0x7F;
+            if ((data[1] & 0x81) == 0x81) m_triggers++;  // SD + OS: one-shot
+        }
+        return I2CStatus::OK;
+    }
+    
+    I2CStatus Read(uint8_t addr, uint8_t* buffer, size_t len) override {
+        int dev = Device(addr);
+        if (dev < 0) return I2CStatus::Nack;
+        m_transactions++;
+        m_reads++;
+        uint16_t reg = (m_pointer[dev] == 0x00) ? (uint16_t)(m_tempQ4[dev] << 4)
+                                                : (uint16_t)(m_config[dev] << 8);
+        if (len >= 1) buffer[0] = (uint8_t)(reg >> 8);
+        if (len >= 2) buffer[1] = (uint8_t)(reg & 0xFF);
+        return I2CStatus::OK;
+    }
+    
+    uint32_t GetTransactions() const { return m_transactions; }
+    uint32_t GetReads() const { return m_reads; }
+    uint32_t GetPointerWrites() const { return m_pointerWrites; }
+    uint32_t GetTriggers() const { return m_triggers; }
+    
+private:
+    uint8_t m_present = 0xFF;
+    uint8_t m_pointer[8] = {0};
+    uint8_t m_config[8] = {0};
+    int16_t m_tempQ4[8];
+    uint32_t m_transactions = 0;
+    uint32_t m_reads = 0;
+    uint32_t m_pointerWrites = 0;
+    uint32_t m_triggers = 0;
+    
+    int Device(uint8_t addr) const {
+        if (addr < 0x48 || addr > 0x4F || !(m_present & (1u << (addr - 0x48)))) {
+            return -1;
+        }
+        return addr - 0x48;
+    }
+};
+
+void TestSensorArray() {
+    TestHeader("TEST 24: Multi-Sensor TMP100 Array");
+    
+    // Test: Continuous mode - a sweep is N bare reads
+    MultiTMP100Mock bus;
+    TMP100Array<8> array(bus);
+    Assert(array.Init(TMP100::ConversionMode::Continuous), "Eight sensors initialized");
+    Assert(array.GetPresentMask() == 0xFF, "All eight present");
+    
+    int16_t values[8];
+    array.Sweep(values);  // First sweep selects each temperature register
+    uint32_t before = bus.GetTransactions();
+    uint8_t mask = array.Sweep(values);
+    uint32_t sweepCost = bus.GetTransactions() - before;
+    printf("  [*] Continuous sweep of 8 sensors: %u transactions\n", (unsigned int)sweepCost);
+    Assert(mask == 0xFF, "Every channel read");
+    Assert(sweepCost == 8, "Sweep costs exactly N reads");
+    Assert(values[0] == 320 && values[7] == 376, "Channel values from the right addresses");
+    
+    // Test: One-shot mode - trigger all, then sweep
+    MultiTMP100Mock bus2;
+    TMP100Array<4> oneShot(bus2);
+    oneShot.Init();
+    before = bus2.GetTransactions();
+    Assert(oneShot.TriggerAll(), "Trigger all conversions");
+    Assert(bus2.GetTriggers() == 4, "One trigger per sensor");
+    Assert(oneShot.GetConversionTimeMs() == 600, "Wait one 12-bit conversion for all");
+    int16_t four[4];
+    Assert(oneShot.Sweep(four) == 0x0F, "One-shot sweep reads all channels");
+    Assert(bus2.GetTransactions() - before == 4 + 4 * 2, "Trigger + pointer write + read per sensor");
+    
+    // Test: Missing sensors are skipped, not retried
+    MultiTMP100Mock bus3;
+    bus3.SetPresent(0xF5);  // 0x49 and 0x4B absent
+    TMP100Array<8> partial(bus3);
+    Assert(!partial.Init(TMP100::ConversionMode::Continuous), "Init reports missing sensors");
+    Assert(partial.GetPresentMask() == 0xF5, "Present mask excludes 0x49 and 0x4B");
+    partial.Sweep(values);
+    before = bus3.GetTransactions();
+    mask = partial.Sweep(values);
+    Assert(mask == 0xF5 && bus3.GetTransactions() - before == 6, "Sweep touches only present sensors");
+    Assert(values[1] == TMP100Array<8>::INVALID, "Missing channel marked invalid");
+    
+    // Test: Multi-channel records through the page writer
+    RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    EEPROMPageWriter writer(eeprom);
+    bool ok = true;
+    for (uint32_t s = 0; s < 5; s++) {
+        values[0] = (int16_t)(s * 16);
+        ok = TMP100Array<8>::LogSweep(writer, 1000 + s * 600, values, mask) && ok;
+    }
+    Assert(ok && writer.Flush(), "Five sweeps logged");
+    Assert(i2c.GetEepromDataWrites() <= 3, "Records batched into page writes");
+    
+    uint8_t raw[TMP100Array<8>::RECORD_BYTES];
+    eeprom.ReadBytes(4 * TMP100Array<8>::RECORD_BYTES, raw, sizeof(raw));  // Spans a page
+    uint32_t t = 0;
+    int16_t back[8];
+    uint8_t backMask = 0;
+    TMP100Array<8>::DecodeRecord(raw, t, back, backMask);
+    Assert(t == 1000 + 4 * 600 && backMask == 0xF5 && back[0] == 64 && back[2] == values[2] &&
+           back[1] == TMP100Array<8>::INVALID, "Record decodes across a page boundary");
+    
+    // Test: Page write failing in the middle of a record stages none of it
+    RealI2CMock i2c2;
+    FlakyI2C flaky(i2c2);
+    EEPROM24FC256 eeprom2(flaky, 0x50);
+    EEPROMPageWriter writer2(eeprom2);
+    Assert(TMP100Array<8>::LogSweep(writer2, 1000, values, mask) &&
+           TMP100Array<8>::LogSweep(writer2, 1600, values, mask), "Two records staged (44 of 64 bytes)");
+    flaky.FailNext(1);  // The page write at word 10 of the third record
+    Assert(!TMP100Array<8>::LogSweep(writer2, 2200, values, mask) &&
+           writer2.GetWriteAddress() == 2 * TMP100Array<8>::RECORD_BYTES, "Failed record is not staged");
+    values[0] = 99;
+    Assert(TMP100Array<8>::LogSweep(writer2, 2800, values, mask) && writer2.Flush(),
+           "Next record retries the page write");
+    eeprom2.ReadBytes(2 * TMP100Array<8>::RECORD_BYTES, raw, sizeof(raw));
+    TMP100Array<8>::DecodeRecord(raw, t, back, backMask);
+    Assert(t == 2800 && backMask == 0xF5 && back[0] == 99, "Record stream stays aligned after the failure");
+}
+
+// ============================================================================
+// TEST 25: Fixed-Point Temperature Pipeline
+// ============================================================================
+
+void TestFixedPointTemperature() {
+    TestHeader("TEST 25: Fixed-Point Temperature Pipeline");
+    
+    // Test: Conversions are exact in Q12.4 and usable at compile time
+    static_assert(Temperature::FromDegrees(25).Raw() == 400, "constexpr degrees");
+    static_assert(Temperature::FromCentiDegrees(-2550).Raw() == -408, "constexpr centidegrees");
+    Assert(Temperature::FromRaw(344).CentiDegrees() == 2150, "21.5 C is 2150 centidegrees");
+    Assert(Temperature::FromRaw(1).CentiDegrees() == 6, "One LSB rounds to 0.06 C");
+    Assert(Temperature::FromRaw(-1).CentiDegrees() == -6, "Negative LSB rounds symmetrically");
+    Assert(Temperature::FromCentiDegrees(2153).Raw() == 344, "2153 centidegrees rounds to 21.5 C");
+    Assert(Temperature::FromRaw(-880).WholeDegrees() == -55, "-55 C whole degrees");
+    Assert(Temperature::FromRaw(-8).WholeDegrees() == 0, "-0.5 C truncates toward zero");
+    
+    // Test: Every centidegree value in the sensor range survives a round trip
+    bool roundTrip = true;
+    for (int16_t q4 = -55 * 16; q4 <= 125 * 16; q4++) {
+        Temperature t = Temperature::FromRaw(q4);
+        roundTrip = roundTrip && Temperature::FromCentiDegrees(t.CentiDegrees()) == t;
+    }
+    Assert(roundTrip, "Raw -> centidegrees -> raw is lossless from -55 to 125 C");
+    
+    // Test: Host float helpers match the old encoder exactly
+    bool sameAsFloat = true;
+    for (float f = -55.0f; f <= 125.0f; f += 0.37f) {
+        sameAsFloat = sameAsFloat &&
+            Temperature::FromFloat(f).Raw() == EEPROM24FC256::EncodeTemperature(f) &&
+            Temperature::FromFloat(f).ToFloat() == EEPROM24FC256::DecodeTemperature(EEPROM24FC256::EncodeTemperature(f));
+    }
+    Assert(sameAsFloat, "FromFloat/ToFloat agree with EncodeTemperature/DecodeTemperature");
+    
+    // Test: Ordering and arithmetic stay in fixed point
+    Temperature low = Temperature::FromDegrees(18);
+    Temperature high = Temperature::FromDegrees(27);
+    Assert(low < high && high - low == Temperature::FromDegrees(9), "Compare and subtract");
+    Assert(low + Temperature::FromRaw(8) == Temperature::FromCentiDegrees(1850), "Add half a degree");
+    
+    // Test: Sensor read -> EEPROM -> read back without floats
+    RealI2CMock i2c;
+    TMP100 sensor(i2c, 0x48);
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    sensor.Init();
+    i2c.SetSimulatedTemperature(-12.25f);
+    Temperature reading;
+    Assert(sensor.ReadTemperature(reading), "Integer sensor read");
+    Assert(reading.Raw() == -196, "Read -12.25 C as -196");
+    Assert(eeprom.LogData(0x0100, reading), "Log Temperature");
+    Temperature stored;
+    Assert(eeprom.ReadData(0x0100, stored) && stored == reading, "Read back the same value");
+    Assert(eeprom.ReadData(0x0100) == -12.25f, "Float read of the same sample (host-side)");
+    
+    // Test: Thresholds from Temperature write the same registers as floats
+    Assert(sensor.SetThresholds(low, high), "Program band from Temperature");
+    uint16_t tlow = i2c.GetTmp100Limit(0);
+    uint16_t thigh = i2c.GetTmp100Limit(1);
+    sensor.SetThresholds(18.0f, 27.0f);
+    Assert(tlow == 0x1200 && tlow == i2c.GetTmp100Limit(0) && thigh == i2c.GetTmp100Limit(1),
+           "Same TLOW/THIGH as the float overload");
+    Assert(!sensor.SetThresholds(high, low), "Inverted band rejected");
+    
+    // Test: Failed read leaves the value untouched
+    FlakyI2C flaky(i2c);
+    TMP100 flakySensor(flaky, 0x48);
+    Temperature keep = Temperature::FromDegrees(5);
+    flaky.FailNext(1);
+    Assert(!flakySensor.ReadTemperature(keep) && keep == Temperature::FromDegrees(5),
+           "I2C error reported, value unchanged");
+}
+
+// ============================================================================
+// TEST 26: Integer Filter Pipeline and Oversampling
+// ============================================================================
+
+void TestFilterPipeline() {
+    TestHeader("TEST 26: Integer Filter Pipeline and Oversampling");
+    
+    // Test: Median rejects a short spike completely
+    MedianFilter<5> median;
+    const int16_t spiky[] = { 352, 353, 480, 351, 352, 354, 200, 352 };
+    bool spikeFree = true;
+    for (int16_t v : spiky) {
+        Temperature out = median.Push(Temperature::FromRaw(v));
+        spikeFree = spikeFree && out.Raw() >= 351 && out.Raw() <= 354;
+    }
+    Assert(spikeFree, "Median output never follows a single-sample spike");
+    Assert(median.GetCount() == 5, "Median window holds N readings");
+    median.Reset();
+    median.Push(Temperature::FromRaw(-10));
+    Assert(median.Push(Temperature::FromRaw(-13)).Raw() == -12, "Even count: middle pair mean, rounded");
+    
+    // Test: Moving average over the last N readings, rounded
+    MovingAverage<4> average;
+    average.Push(Temperature::FromRaw(100));
+    Assert(average.Push(Temperature::FromRaw(101)).Raw() == 101, "Partial window mean 100.5 rounds up");
+    average.Push(Temperature::FromRaw(102));
+    average.Push(Temperature::FromRaw(103));
+    Assert(average.Push(Temperature::FromRaw(200)).Raw() == 127, "Oldest reading leaves the window");
+    average.Reset();
+    average.Push(Temperature::FromRaw(-100));
+    Assert(average.Push(Temperature::FromRaw(-101)).Raw() == -101, "Negative mean rounds away from zero");
+    
+    // Test: IIR starts at the first reading and converges on a step
+    IIRFilter<2> iir;
+    Assert(iir.Push(Temperature::FromDegrees(20)) == Temperature::FromDegrees(20), "IIR primed by first reading");
+    Temperature step = iir.Push(Temperature::FromDegrees(24));
+    Assert(step == Temperature::FromDegrees(21), "One step moves 1/4 of the way");
+    for (int i = 0; i < 40; i++) {
+        step = iir.Push(Temperature::FromDegrees(24));
+    }
+    Assert(step == Temperature::FromDegrees(24), "IIR settles exactly on the new level");
+    IIRFilter<4> negative;
+    negative.Push(Temperature::FromDegrees(-10));
+    for (int i = 0; i < 200; i++) {
+        step = negative.Push(Temperature::FromDegrees(-20));
+    }
+    Assert(step == Temperature::FromDegrees(-20), "IIR settles below zero");
+    
+    // Test: Chain feeds median output into the average
+    FilterChain<MedianFilter<3>, MovingAverage<2>> chain;
+    chain.Push(Temperature::FromRaw(320));
+    chain.Push(Temperature::FromRaw(320));
+    Assert(chain.Push(Temperature::FromRaw(800)).Raw() == 320, "Spike removed before averaging");
+    
+    // Test: Oversampler collapses a burst into one value
+    Oversampler<FilterChain<MedianFilter<5>, MovingAverage<4>>> burst;
+    Temperature logged;
+    Assert(!burst.Collapse(logged), "Empty burst yields no value");
+    for (int16_t v : spiky) {
+        burst.Add(Temperature::FromRaw(v));
+    }
+    Assert(burst.GetCount() == 8, "Eight readings in the burst");
+    Assert(burst.Collapse(logged) && logged.Raw() >= 351 && logged.Raw() <= 354, "Burst collapsed to 22 C");
+    Assert(burst.GetCount() == 0 && !burst.Collapse(logged), "Collapse starts a new burst");
+    burst.Add(Temperature::FromRaw(-40));
+    Assert(burst.Collapse(logged) && logged.Raw() == -40, "Previous burst does not leak into the next");
+    
+    // Test: Sensor readings through the pipeline, one EEPROM sample per burst
+    RealI2CMock i2c;
+    TMP100 sensor(i2c, 0x48);
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    sensor.Init();
+    const float readings[] = { 22.0f, 22.0625f, 29.5f, 21.9375f, 22.0f, 22.0f, 22.0625f, 22.0f, 22.0f, 22.0f };
+    for (float t : readings) {
+        i2c.SetSimulatedTemperature(t);
+        Temperature r;
+        sensor.ReadTemperature(r);
+        burst.Add(r);
+    }
+    uint32_t writesBefore = i2c.GetEepromDataWrites();
+    Assert(burst.Collapse(logged) && eeprom.LogData(0x0200, logged), "Burst logged");
+    Assert(i2c.GetEepromDataWrites() - writesBefore == 1, "Ten readings cost one EEPROM sample");
+    Temperature stored;
+    Assert(eeprom.ReadData(0x0200, stored) && stored == Temperature::FromDegrees(22),
+           "Draft spike filtered out of the logged value");
+}
+
+// ============================================================================
+// TEST 27: Scatter-Gather Writes and Batched Transfers
+// ============================================================================
+
+/// Forwards to another bus, recording gathered writes and batches
+class GatherSpyI2C : public II2CController {
+public:
+    explicit GatherSpyI2C(II2CController& bus) : m_bus(bus) {}
+    
+    I2CStatus Write(uint8_t addr, const uint8_t* data, size_t len) override {
+        m_writes++;
+        return m_bus.Write(addr, data, len);
+    }
+    
+    I2CStatus Read(uint8_t addr, uint8_t* buffer, size_t len) override {
+        return m_bus.Read(addr, buffer, len);
+    }
+    
+    I2CStatus WriteRead(uint8_t addr, const uint8_t* tx, size_t txLen,
+                        uint8_t* rx, size_t rxLen) override {
+        return m_bus.WriteRead(addr, tx, txLen, rx, rxLen);
+    }
+    
+    I2CStatus WriteV(uint8_t addr, const uint8_t* header, size_t headerLen,
+                     const uint8_t* data, size_t dataLen) override {
+        m_writeVs++;
+        m_lastHeaderLen = headerLen;
+        m_lastData = data;
+        return m_bus.WriteV(addr, header, headerLen, data, dataLen);
+    }
+    
+    I2CStatus Transfer(I2CTransaction* list, size_t count) override {
+        m_transfers++;
+        m_entries += count;
+        return m_bus.Transfer(list, count);
+    }
+    
+    uint32_t GetWrites() const { return m_writes; }
+    uint32_t GetWriteVs() const { return m_writeVs; }
+    size_t GetLastHeaderLen() const { return m_lastHeaderLen; }
+    const uint8_t* GetLastData() const { return m_lastData; }
+    uint32_t GetTransfers() const { return m_transfers; }
+    uint32_t GetEntries() const { return m_entries; }
+    
+private:
+    II2CController& m_bus;
+    uint32_t m_writes = 0;
+    uint32_t m_writeVs = 0;
+    size_t m_lastHeaderLen = 0;
+    const uint8_t* m_lastData = nullptr;
+    uint32_t m_transfers = 0;
+    uint32_t m_entries = 0;
+};
+
+void TestScatterGather() {
+    TestHeader("TEST 27: Scatter-Gather Writes and Batched Transfers");
+    
+    // Test: Page write hands the caller's buffer to the bus untouched
+    RealI2CMock i2c;
+    GatherSpyI2C spy(i2c);
+    EEPROM24FC256 eeprom(spy, 0x50);
+    uint8_t page[64];
+    for (uint8_t i = 0; i < 64; i++) {
+        page[i] = (uint8_t)(i * 3);
+    }
+    Assert(eeprom.WritePage(0x0440, page, sizeof(page)), "Full page written");
+    Assert(spy.GetWriteVs() == 1 && spy.GetLastHeaderLen() == 2, "One gathered write, 2 address bytes");
+    Assert(spy.GetLastData() == page, "Payload passed by pointer, not staged");
+    uint8_t back[64];
+    Assert(eeprom.ReadBytes(0x0440, back, sizeof(back)) && std::memcmp(back, page, 64) == 0,
+           "Default WriteV delivers header + data as one write");
+    Assert(i2c.GetEepromBusBytes() == 2 + 64, "Same 66 bus bytes as a contiguous write");
+    
+    // Test: Default WriteV limits
+    uint8_t big[II2CController::WRITEV_STAGING];
+    std::memset(big, 0, sizeof(big));
+    uint8_t hdr[2] = { 0x00, 0x00 };
+    Assert(i2c.WriteV(0x50, hdr, 2, big, sizeof(big)) == I2CStatus::Error, "Oversized gather rejected");
+    Assert(i2c.WriteV(0x50, nullptr, 0, nullptr, 0) == I2CStatus::OK, "Empty gather is a zero-length write (ACK poll)");
+    Assert(i2c.WriteV(0x50, hdr, 2, nullptr, 0) == I2CStatus::OK, "Header-only gather sets the address pointer");
+    
+    // Test: Native gather in MockEEPROM writes both spans in place
+    MockI2C mock;
+    uint8_t addrBytes[2] = { 0x01, 0x00 };
+    uint8_t payload[4] = { 0xDE, 0xAD, 0xBE, 0xEF };
+    Assert(mock.WriteV(0x50, addrBytes, 2, payload, 4) == I2CStatus::OK, "MockI2C gathered write");
+    const uint8_t* mem = mock.GetEEPROMMock().GetMemory();
+    Assert(mem[0x100] == 0xDE && mem[0x103] == 0xEF, "Data lands at the gathered address");
+    uint8_t split[1] = { 0x02 };
+    uint8_t rest[3] = { 0x00, 0x11, 0x22 };
+    while (mock.WriteV(0x50, addrBytes, 2, nullptr, 0) != I2CStatus::OK) {}  // Poll out the write cycle
+    Assert(mock.WriteV(0x50, split, 1, rest, 3) == I2CStatus::OK && mem[0x200] == 0x11 && mem[0x201] == 0x22,
+           "Address may straddle the two spans");
+    
+    // Test: Batch of mixed transactions, each with its own status
+    RealI2CMock bus;
+    FlakyI2C flaky(bus);
+    bus.SetSimulatedTemperature(23.5f);
+    uint8_t eepromAddr[2] = { 0x00, 0x80 };
+    uint8_t eepromData[3] = { 1, 2, 3 };
+    uint8_t tempPointer = 0x00;
+    uint8_t tempRx[2] = { 0, 0 };
+    uint8_t readBack[3] = { 0, 0, 0 };
+    I2CTransaction batch[4] = {
+        { 0x50, eepromAddr, 2, eepromData, 3, nullptr, 0, I2CStatus::Error },
+        { 0x48, &tempPointer, 1, nullptr, 0, tempRx, 2, I2CStatus::Error },
+        { 0x50, eepromAddr, 2, eepromData, 3, readBack, 3, I2CStatus::Error },
+        { 0x50, eepromAddr, 2, nullptr, 0, readBack, 3, I2CStatus::Error },
+    };
+    flaky.FailNext(1);
+    Assert(flaky.Transfer(batch, 4) == I2CStatus::Nack, "First failure reported");
+    Assert(batch[0].status == I2CStatus::Nack, "Failed write has its own status");
+    Assert(batch[1].status == I2CStatus::OK && ((tempRx[0] << 8) | tempRx[1]) >> 4 == 376,
+           "Later entries still run: pointer write + read");
+    Assert(batch[2].status == I2CStatus::Error, "Read after gathered data unsupported by default");
+    Assert(batch[3].status == I2CStatus::OK, "Random read in the same batch");
+    Assert(bus.Transfer(batch, 1) == I2CStatus::OK && bus.Transfer(&batch[3], 1) == I2CStatus::OK &&
+           readBack[0] == 1 && readBack[2] == 3, "Retried write reads back");
+    
+    // Test: A sweep is one batch, one bus call for all sensors
+    MultiTMP100Mock sensors;
+    GatherSpyI2C sweepSpy(sensors);
+    TMP100Array<8> array(sweepSpy);
+    array.Init(TMP100::ConversionMode::Continuous);
+    int16_t values[8];
+    array.Sweep(values);
+    uint32_t transfersBefore = sweepSpy.GetTransfers();
+    uint32_t readsBefore = sensors.GetReads();
+    uint8_t mask = array.Sweep(values);
+    Assert(sweepSpy.GetTransfers() - transfersBefore == 1 && sweepSpy.GetEntries() == 16,
+           "Each sweep is one Transfer of 8 entries");
+    Assert(mask == 0xFF && sensors.GetReads() - readsBefore == 8 && values[3] == 344,
+           "Batched sweep still costs 8 bare reads");
+    
+    // Test: MockI2C runs a batch without per-entry virtual dispatch
+    MockI2C mock2;
+    I2CTransaction one = { 0x50, addrBytes, 2, payload, 4, nullptr, 0, I2CStatus::Error };
+    Assert(mock2.Transfer(&one, 1) == I2CStatus::OK && mock2.GetEEPROMMock().GetMemory()[0x101] == 0xAD,
+           "MockI2C batch writes through the gathered path");
+}
+
+// ============================================================================
+// TEST 28: Static Bus Binding
+// ============================================================================
+
+void TestStaticBinding() {
+    TestHeader("TEST 28: Static Bus Binding");
+    
+    // Test: Concrete buses are final, so bound drivers need no vtable lookups
+    static_assert(std::is_final<MockI2C>::value, "MockI2C is final");
+    static_assert(std::is_final<RealI2CMock>::value, "RealI2CMock is final");
+    static_assert(sizeof(TMP100T<RealI2CMock>) == sizeof(TMP100), "Same footprint as the adapter binding");
+    static_assert(std::is_same<TMP100T<MockI2C>::ConversionMode, TMP100::ConversionMode>::value,
+                  "Settings shared by every binding");
+    
+    // Test: Statically bound sensor matches the adapter, transaction for transaction
+    RealI2CMock direct;
+    RealI2CMock adapted;
+    TMP100T<RealI2CMock> bound(direct, 0x48);
+    TMP100 virt(adapted, 0x48);
+    bool same = bound.Init(TMP100Base::ConversionMode::OneShot) && virt.Init(TMP100Base::ConversionMode::OneShot);
+    for (int i = 0; i < 5; i++) {
+        direct.SetSimulatedTemperature(18.0f + i * 1.25f);
+        adapted.SetSimulatedTemperature(18.0f + i * 1.25f);
+        Temperature a;
+        Temperature b;
+        same = same && bound.StartConversion() && virt.StartConversion() &&
+               bound.ReadTemperature(a) && virt.ReadTemperature(b) && a == b;
+    }
+    Assert(same, "Bound and adapted sensors read the same values");
+    Assert(direct.GetTmp100Writes() == adapted.GetTmp100Writes() &&
+           direct.GetTmp100Reads() == adapted.GetTmp100Reads(), "Same bus traffic");
+    
+    // Test: Statically bound EEPROM over the concrete controller
+    EEPROM24FC256T<RealI2CMock> eeprom(direct, 0x50);
+    uint8_t page[64];
+    for (uint8_t i = 0; i < 64; i++) {
+        page[i] = (uint8_t)(0xA0 ^ i);
+    }
+    uint8_t back[64];
+    Assert(eeprom.WritePage(0x0800, page, sizeof(page)) && eeprom.ReadBytes(0x0800, back, sizeof(back)) &&
+           std::memcmp(page, back, sizeof(page)) == 0, "Bound EEPROM page round trip");
+    Assert(eeprom.LogData(0x0900, Temperature::FromRaw(-77)), "Bound EEPROM logs a sample");
+    EEPROM24FC256 view(direct, 0x50);
+    Temperature t;
+    Assert(view.ReadData(0x0900, t) && t.Raw() == -77, "Adapter sees the same device contents");
+    
+    // Test: Bound to MockI2C (as in main.cpp)
+    MockI2C mock;
+    EEPROM24FC256T<MockI2C> mockEeprom(mock, 0x50);
+    uint8_t bytes[3] = { 7, 8, 9 };
+    uint8_t got[3] = { 0, 0, 0 };
+    Assert(mockEeprom.WritePage(0x0010, bytes, 3) && mockEeprom.ReadBytes(0x0010, got, 3) && got[2] == 9,
+           "MockI2C-bound EEPROM round trip");
+    TMP100T<MockI2C> mockSensor(mock, 0x48);
+    Assert(!mockSensor.Init(), "MockI2C-bound sensor reports the missing TMP100");
+    
+    // Test: Bound array sweeps as one batch
+    MultiTMP100Mock sensors;
+    TMP100Array<4, MultiTMP100Mock> array(sensors);
+    Assert(array.Init(TMP100Base::ConversionMode::Continuous), "Bound array initialized");
+    int16_t values[4];
+    array.Sweep(values);
+    uint32_t before = sensors.GetTransactions();
+    Assert(array.Sweep(values) == 0x0F && sensors.GetTransactions() - before == 4 && values[2] == 336,
+           "Bound sweep: 4 bare reads");
+}
+
+// ============================================================================
+// TEST 29: Async I2C Submission
+// ============================================================================
+
+struct AsyncTrace {
+    MockAsyncI2C* bus;
+    uint8_t order[8];
+    uint8_t count;
+    bool allInInterrupt;
+    I2CTransaction* chained;  // Submitted from the first callback, if set
+};
+
+static void RecordCompletion(void* context, I2CTransaction& t) {
+    AsyncTrace* trace = static_cast<AsyncTrace*>(context);
+    trace->allInInterrupt = trace->allInInterrupt && trace->bus->InInterrupt();
+    if (trace->count < 8) {
+        trace->order[trace->count++] = t.header[0];
+    }
+    if (trace->chained != nullptr) {
+        I2CTransaction* next = trace->chained;
+        trace->chained = nullptr;
+        trace->bus->Submit(*next, &RecordCompletion, trace);
+    }
+}
+
+void TestAsyncI2C() {
+    TestHeader("TEST 29: Async I2C Submission");
+    
+    RealI2CMock devices;
+    MockAsyncI2C bus(devices);
+    AsyncTrace trace = { &bus, {0}, 0, true, nullptr };
+    
+    // Test: Submit only queues; the transfer runs when its last byte is out
+    uint8_t regs[4] = { 0x00, 0x01, 0x02, 0x03 };
+    uint8_t rx[2] = { 0, 0 };
+    I2CTransaction setPtr = { 0x48, &regs[1], 1, nullptr, 0, nullptr, 0, I2CStatus::Error };
+    I2CTransaction readTemp = { 0x48, &regs[0], 1, nullptr, 0, rx, 2, I2CStatus::Error };
+    Assert(bus.Submit(setPtr, &RecordCompletion, &trace) && bus.Submit(readTemp, &RecordCompletion, &trace),
+           "Two transactions queued");
+    Assert(bus.IsBusy() && bus.GetQueued() == 2 && devices.GetTmp100Writes() == 0 && trace.count == 0,
+           "Nothing on the devices before the bus runs");
+    bus.Tick(1);
+    Assert(trace.count == 0 && devices.GetTmp100Writes() == 0, "Partial transfer has not completed");
+    bus.Tick(1);
+    Assert(trace.count == 1 && setPtr.status == I2CStatus::OK && bus.GetQueued() == 1,
+           "First transfer completes after its 2 wire bytes");
+    bus.Drain();
+    Assert(trace.count == 2 && trace.order[0] == 0x01 && trace.order[1] == 0x00, "Callbacks in FIFO order");
+    Assert(trace.allInInterrupt && !bus.InInterrupt(), "Callbacks run in interrupt context");
+    Assert(readTemp.status == I2CStatus::OK && ((rx[0] << 8) | rx[1]) == 0x1680, "Read phase filled rx (22.5 C)");
+    Assert(bus.GetWireBytes() == 2 + 5, "Wire bytes: addr+ptr, addr+ptr+addr+2 data");
+    
+    // Test: Queue depth is bounded; a full queue refuses without side effects
+    I2CTransaction many[MockAsyncI2C::QUEUE_DEPTH + 1];
+    bool accepted = true;
+    for (uint8_t i = 0; i < MockAsyncI2C::QUEUE_DEPTH; i++) {
+        many[i] = { 0x48, &regs[1], 1, nullptr, 0, nullptr, 0, I2CStatus::Error };
+        accepted = accepted && bus.Submit(many[i], nullptr, nullptr);
+    }
+    many[MockAsyncI2C::QUEUE_DEPTH] = many[0];
+    Assert(accepted && !bus.Submit(many[MockAsyncI2C::QUEUE_DEPTH], nullptr, nullptr), "Full queue refuses");
+    bus.Drain();
+    Assert(!bus.IsBusy() && bus.GetCompleted() == 2 + MockAsyncI2C::QUEUE_DEPTH, "Queue drained");
+    
+    // Test: A callback can chain the next transfer
+    trace.count = 0;
+    I2CTransaction second = { 0x48, &regs[3], 1, nullptr, 0, nullptr, 0, I2CStatus::Error };
+    trace.chained = &second;
+    bus.Submit(setPtr, &RecordCompletion, &trace);
+    bus.Drain();
+    Assert(trace.count == 2 && trace.order[1] == 0x03 && second.status == I2CStatus::OK,
+           "Transfer submitted from a callback ran");
+    
+    // Test: Double-buffered pages: the CPU stages page 2 while page 1 is on the wire
+    RealI2CMock eepromDevices;
+    MockAsyncI2C eepromBus(eepromDevices);
+    AsyncPageWriter writer(eepromBus, 0x50, 0x0400);
+    bool appended = true;
+    for (int16_t i = 0; i < 32; i++) {
+        appended = writer.Append(static_cast<int16_t>(i * 3 - 40)) && appended;
+    }
+    Assert(appended && eepromBus.GetQueued() == 1 && eepromDevices.GetEepromDataWrites() == 0, "Full page submitted, not blocking");
+    uint32_t staged = 0;
+    for (int16_t i = 0; i < 32; i++) {
+        eepromBus.Tick(3);  // Bus shifts 3 bytes per sample computed (67-byte page write)
+        staged += writer.Append(Temperature::FromRaw(static_cast<int16_t>(1000 + i))) ? 1 : 0;
+    }
+    Assert(staged == 32 && writer.GetPagesWritten() == 1, "Page 2 staged while page 1 completed");
+    eepromBus.Drain();
+    writer.Poll();
+    Assert(writer.IsIdle() && writer.GetPagesWritten() == 2 && eepromDevices.GetEepromDataWrites() == 2,
+           "Two page writes, one transaction each");
+    
+    EEPROM24FC256 reader(eepromDevices, 0x50);
+    Temperature first;
+    Temperature last;
+    Assert(reader.ReadData(0x0400, first) && first.Raw() == -40 &&
+           reader.ReadData(0x0400 + 64 + 62, last) && last.Raw() == 1031, "Both pages hold their samples");
+    
+    // Test: NACK during the write cycle is retried from the main loop, not the ISR
+    eepromDevices.SetWriteCyclePolls(2);
+    for (int16_t i = 0; i < 64; i++) {
+        writer.Append(static_cast<int16_t>(500 + i));
+    }
+    uint32_t wireBefore = eepromBus.GetWireBytes();
+    uint32_t polls = 0;
+    while (!writer.Poll() && polls < 20) {
+        eepromBus.Drain();
+        polls++;
+    }
+    Assert(writer.IsIdle() && writer.GetRetries() == 1 && writer.GetPagesWritten() == 4,
+           "Second page NACKed once, then written");
+    Assert(writer.GetAckPolls() == 2 && eepromBus.GetWireBytes() - wireBefore == 3 * 67 + 2,
+           "Busy device ACK-polled with 1-byte transactions, page resent once");
+    uint8_t ackPoll[2] = { 0x00, 0x00 };
+    while (eepromDevices.Write(0x50, ackPoll, sizeof(ackPoll)) == I2CStatus::Nack) {
+    }
+    Assert(reader.ReadData(0x0400 + 3 * 64 + 62, last) && last.Raw() == 563, "Retried page contents intact");
+    
+    // Test: A flushed partial page is continued, not rewritten from its start
+    eepromDevices.SetWriteCyclePolls(0);
+    writer.Append(static_cast<int16_t>(-1));
+    writer.Append(static_cast<int16_t>(-2));
+    uint32_t bytesBefore = eepromDevices.GetEepromBusBytes();
+    Assert(writer.Flush(), "Partial page submitted");
+    eepromBus.Drain();
+    writer.Append(static_cast<int16_t>(-3));
+    writer.Flush();
+    eepromBus.Drain();
+    Assert(writer.IsIdle() && eepromDevices.GetEepromBusBytes() - bytesBefore == (2 + 4) + (2 + 2),
+           "Second flush writes only the new sample");
+    Assert(reader.ReadData(0x0400 + 4 * 64 + 4, last) && last.Raw() == -3 &&
+           reader.ReadData(0x0400 + 4 * 64, first) && first.Raw() == -1, "Continued page reads back");
+    Assert(writer.Flush(), "Nothing pending: flush is a no-op");
+    
+    // Test: Odd start address is rounded up to a sample boundary
+    AsyncPageWriter oddWriter(eepromBus, 0x50, 0x0801);
+    for (int16_t i = 0; i < 32; i++) {
+        oddWriter.Append(static_cast<int16_t>(700 + i));
+    }
+    eepromBus.Drain();
+    oddWriter.Flush();
+    eepromBus.Drain();
+    Assert(oddWriter.IsIdle() && reader.ReadData(0x0802, first) && first.Raw() == 700 &&
+           reader.ReadData(0x0840, last) && last.Raw() == 731, "Odd start: samples stay 2-byte aligned");
+}
+
+// ============================================================================
+// TEST 30: Bus Timing Model
+// ============================================================================
+
+void TestBusTiming() {
+    TestHeader("TEST 30: Bus Timing Model");
+    
+    // Test: START + (address + 2 bytes) x 9 + STOP = 29 SCL periods
+    RealI2CMock devices;
+    TimedI2C bus(devices, TimedI2C::BusSpeed::FastPlus);
+    uint8_t rx[2];
+    bus.Read(0x48, rx, sizeof(rx));
+    Assert(bus.GetBusMicros() == 29 && bus.GetTransactions() == 1, "2-byte read: 29 us at 1 MHz");
+    bus.Reset();
+    bus.SetSpeed(TimedI2C::BusSpeed::Standard);
+    uint8_t ptr = 0x00;
+    bus.WriteRead(0x48, &ptr, 1, rx, sizeof(rx));
+    Assert(bus.GetBusMicros() == 480, "Pointer write + repeated START read: 48 periods at 100 kHz");
+    
+    // Test: Same sensor workload scales with SCL frequency
+    uint64_t micros[3];
+    const TimedI2C::BusSpeed speeds[3] = {
+        TimedI2C::BusSpeed::Standard, TimedI2C::BusSpeed::Fast, TimedI2C::BusSpeed::FastPlus };
+    for (uint8_t s = 0; s < 3; s++) {
+        bus.Reset();
+        bus.SetSpeed(speeds[s]);
+        TMP100 sensor(bus, 0x48);
+        Temperature t;
+        sensor.Init();
+        bus.Advance(600000);  // First continuous conversion
+        for (int i = 0; i < 10; i++) {
+            sensor.ReadTemperature(t);
+        }
+        micros[s] = bus.GetBusMicros();
+    }
+    Assert(micros[0] == 4 * micros[1] && micros[0] == 10 * micros[2], "Bus time scales 1 : 1/4 : 1/10");
+    
+    // Test: ACK polling runs until the write cycle has elapsed
+    bus.Reset();
+    bus.SetSpeed(TimedI2C::BusSpeed::Fast);
+    EEPROM24FC256 eeprom(bus, 0x50);
+    uint8_t page[64];
+    for (uint8_t i = 0; i < 64; i++) {
+        page[i] = i;
+    }
+    eeprom.WritePage(0x0000, page, sizeof(page));
+    uint64_t pageBus = (1 + 9 * 67 + 1) * 25 / 10;  // 1515 us at 400 kHz
+    uint64_t poll = (1 + 9 + 1) * 25 / 10 + TimedI2C::POLL_GAP_US_DEFAULT;
+    Assert(bus.GetBusyNacks() == (TimedI2C::WRITE_CYCLE_US_DEFAULT + poll - 1) / poll,
+           "One NACKed poll per poll period of tWC");
+    Assert(bus.GetElapsedMicros() >= pageBus + TimedI2C::WRITE_CYCLE_US_DEFAULT &&
+           bus.GetElapsedMicros() < pageBus + TimedI2C::WRITE_CYCLE_US_DEFAULT + poll + 10,
+           "Page write ends within one poll of tWC");
+    uint8_t back[64];
+    Assert(eeprom.ReadBytes(0x0000, back, sizeof(back)) && std::memcmp(back, page, sizeof(page)) == 0,
+           "Data passed through to the device");
+    
+    // Test: Page batching against one write cycle per sample
+    bus.Reset();
+    for (uint16_t i = 0; i < 32; i++) {
+        eeprom.LogData(static_cast<uint16_t>(0x0100 + i * 2), Temperature::FromRaw(static_cast<int16_t>(i)));
+    }
+    uint64_t singles = bus.GetElapsedMicros();
+    bus.Reset();
+    eeprom.WritePage(0x0200, page, sizeof(page));
+    uint64_t batched = bus.GetElapsedMicros();
+    Assert(singles >= 32 * TimedI2C::WRITE_CYCLE_US_DEFAULT && singles > 20 * batched,
+           "32 single writes cost 32 write cycles, a page write one");
+    
+    // Test: CPU work overlaps the write cycle in async mode
+    bus.Reset();
+    eeprom.SetAsyncWrites(true);
+    eeprom.WritePage(0x0240, page, sizeof(page));
+    bus.Advance(TimedI2C::WRITE_CYCLE_US_DEFAULT);
+    Assert(eeprom.Poll() && bus.GetBusyNacks() == 0, "Write cycle elapsed during CPU work: first poll ACKs");
+    eeprom.SetAsyncWrites(false);
+    
+    // Test: One-shot read before the conversion is done waits for it
+    bus.Reset();
+    TMP100 oneShot(bus, 0x48);
+    oneShot.Init(TMP100Base::ConversionMode::OneShot, TMP100Base::Resolution::Bits_12);
+    Temperature t;
+    oneShot.StartConversion();
+    oneShot.ReadTemperature(t);
+    Assert(bus.GetConversionWaitMicros() > 599000 && bus.GetConversionWaitMicros() <= 600000,
+           "12-bit conversion: ~600 ms wait");
+    oneShot.StartConversion();
+    bus.Advance(oneShot.GetConversionTimeMs() * 1000u);
+    uint64_t waited = bus.GetConversionWaitMicros();
+    oneShot.ReadTemperature(t);
+    Assert(bus.GetConversionWaitMicros() == waited, "Read after GetConversionTimeMs(): no wait");
+    oneShot.SetResolution(TMP100Base::Resolution::Bits_9);
+    oneShot.StartConversion();
+    oneShot.ReadTemperature(t);
+    Assert(bus.GetConversionWaitMicros() - waited > 74000 && bus.GetConversionWaitMicros() - waited <= 75000,
+           "9-bit conversion: ~75 ms wait");
+    
+    // Test: Batched sweep is timed per entry
+    MultiTMP100Mock sensors;
+    TimedI2C sweepBus(sensors, TimedI2C::BusSpeed::Fast);
+    TMP100Array<4> array(sweepBus);
+    array.Init(TMP100Base::ConversionMode::Continuous);
+    sweepBus.Advance(600000);
+    int16_t values[4];
+    array.Sweep(values);
+    sweepBus.Reset();
+    Assert(array.Sweep(values) == 0x0F && sweepBus.GetTransactions() == 4 &&
+           sweepBus.GetBusMicros() == 4 * 29 * 25 / 10, "Cached-pointer sweep: 4 bare reads, 290 us at 400 kHz");
+}
+
+// ============================================================================
+// TEST 31: Bus Traffic Capture and Replay
+// ============================================================================
+
+void TestTrafficCapture() {
+    TestHeader("TEST 31: Bus Traffic Capture and Replay");
+    
+    // Test: Every transaction recorded with shape, status, bytes and timestamp
+    RealI2CMock devices;
+    MockTimer timer;
+    timer.Init();
+    uint8_t buffer[2048];
+    I2CCapture capture(buffer, sizeof(buffer));
+    I2CRecorder recorder(devices, capture, &timer);
+    TMP100 sensor(recorder, 0x48);
+    EEPROM24FC256 eeprom(recorder, 0x50);
+    
+    devices.SetSimulatedTemperature(21.5f);
+    sensor.Init();
+    timer.AdvanceTime(600);
+    Temperature t;
+    sensor.ReadTemperature(t);
+    eeprom.LogData(0x0040, t);
+    Temperature stored;
+    eeprom.ReadData(0x0040, stored);
+    
+    size_t offset = 0;
+    I2CRecord r;
+    Assert(capture.Next(offset, r) && r.op == I2COp::Write && r.addr == 0x48 && r.txLen == 2 &&
+           r.tx[0] == 0x01 && r.status == I2CStatus::OK && r.timestamp == 0, "Config write recorded");
+    Assert(capture.Next(offset, r) && r.addr == 0x48 && r.rxLen == 2 && r.rx[0] == 21 && r.timestamp == 600,
+           "Temperature read recorded with its result and timestamp");
+    Assert(capture.Next(offset, r) && r.op == I2COp::Write && r.addr == 0x50 && r.txLen == 4 &&
+           r.tx[0] == 0x00 && r.tx[1] == 0x40, "Sample write: address + 2 data bytes");
+    uint32_t count = capture.GetRecordCount();
+    Assert(count >= 4 && capture.GetDropped() == 0, "All transactions recorded");
+    
+    // Test: Replay reproduces the session without any device model
+    I2CReplayer replayer(capture);
+    TMP100 replaySensor(replayer, 0x48);
+    EEPROM24FC256 replayEeprom(replayer, 0x50);
+    Temperature rt;
+    Temperature rstored;
+    bool ok = replaySensor.Init() && replaySensor.ReadTemperature(rt) &&
+              replayEeprom.LogData(0x0040, rt) && replayEeprom.ReadData(0x0040, rstored);
+    Assert(ok && rt == t && rstored == stored, "Replayed drivers see the recorded values");
+    Assert(replayer.IsComplete() && replayer.GetDivergence() == I2CReplayer::NO_DIVERGENCE,
+           "Whole capture consumed, no divergence");
+    
+    // Test: A driver leaving the recorded path is caught at the exact transaction
+    I2CReplayer strict(capture);
+    TMP100 changed(strict, 0x48);
+    changed.Init(TMP100Base::ConversionMode::OneShot);  // Different config byte
+    Assert(strict.GetDivergence() == 0 && !strict.IsComplete(), "Divergence at record 0");
+    Assert(!changed.ReadTemperature(rt), "Calls after a divergence fail");
+    
+    // Test: Diff two runs; an extra transaction per sample shows up
+    uint8_t bufA[1024];
+    uint8_t bufB[1024];
+    I2CCapture runA(bufA, sizeof(bufA));
+    I2CCapture runB(bufB, sizeof(bufB));
+    RealI2CMock devA;
+    RealI2CMock devB;
+    I2CRecorder recA(devA, runA);
+    I2CRecorder recB(devB, runB);
+    TMP100 continuous(recA, 0x48);
+    TMP100 oneShot(recB, 0x48);
+    continuous.Init(TMP100Base::ConversionMode::Continuous);
+    oneShot.Init(TMP100Base::ConversionMode::Continuous);
+    Assert(I2CCapture::FirstDifference(runA, runB) == I2CCapture::NO_DIFFERENCE, "Identical runs: no difference");
+    uint32_t before = runB.GetRecordCount();
+    oneShot.Init(TMP100Base::ConversionMode::OneShot);
+    continuous.Init(TMP100Base::ConversionMode::Continuous);  // Same length, different config byte
+    Assert(I2CCapture::FirstDifference(runA, runB) == before, "First difference at the changed config write");
+    runA.Clear();
+    runB.Clear();
+    for (int i = 0; i < 8; i++) {
+        continuous.ReadTemperature(t);
+        oneShot.StartConversion();
+        oneShot.ReadTemperature(t);
+    }
+    Assert(runA.GetRecordCount() == 8 && runB.GetRecordCount() == 16,
+           "Transactions per sample: 1 continuous, 2 one-shot");
+    Assert(runB.GetWireBytes() > 2 * runA.GetWireBytes(), "Wire bytes per sample compared");
+    
+    // Test: Gathered writes and batched transfers as they appear on the wire
+    runA.Clear();
+    EEPROM24FC256 pages(recA, 0x50);
+    uint8_t page[64];
+    std::memset(page, 0x5A, sizeof(page));
+    pages.WritePage(0x0100, page, sizeof(page));
+    offset = 0;
+    Assert(runA.Next(offset, r) && r.op == I2COp::Write && r.txLen == 66 && r.tx[1] == 0x00 && r.tx[2] == 0x5A,
+           "WriteV recorded as one 66-byte write");
+    MultiTMP100Mock sensors;
+    I2CRecorder recSweep(sensors, runB);
+    TMP100Array<4> array(recSweep);
+    array.Init(TMP100Base::ConversionMode::Continuous);
+    int16_t values[4];
+    array.Sweep(values);
+    runB.Clear();
+    array.Sweep(values);
+    offset = 0;
+    bool bare = true;
+    for (uint8_t i = 0; i < 4; i++) {
+        bare = bare && runB.Next(offset, r) && r.op == I2COp::Read && r.addr == 0x48 + i;
+    }
+    Assert(bare && runB.GetRecordCount() == 4, "Sweep batch recorded entry by entry");
+    
+    // Test: Saved capture reloads; overflow drops records but keeps forwarding
+    uint8_t copy[2048];
+    std::memcpy(copy, capture.GetData(), capture.GetSize());
+    I2CCapture reloaded(copy, sizeof(copy), capture.GetSize());
+    Assert(reloaded.GetRecordCount() == count && I2CCapture::FirstDifference(reloaded, capture) == I2CCapture::NO_DIFFERENCE,
+           "Reloaded capture matches");
+    I2CCapture clipped(copy, 16, capture.GetSize());
+    uint8_t payload[8] = {};
+    Assert(clipped.GetSize() <= 16 &&
+           !clipped.Append(I2COp::Write, 0x48, I2CStatus::OK, 0, payload, sizeof(payload), nullptr, 0, nullptr, 0) &&
+           clipped.GetSize() <= 16,
+           "Saved length beyond capacity is clamped");
+    uint8_t tiny[24];
+    I2CCapture small(tiny, sizeof(tiny));
+    I2CRecorder recSmall(devices, small);
+    TMP100 smallSensor(recSmall, 0x48);
+    bool forwarded = smallSensor.Init();
+    for (int i = 0; i < 3; i++) {
+        forwarded = smallSensor.ReadTemperature(t) && forwarded;
+    }
+    Assert(forwarded && small.GetRecordCount() == 1 && small.GetDropped() == 3,
+           "Overflow ends the capture, bus unaffected");
+}
+
+// ============================================================================
+// TEST 32: Retry Policy Layer
+// ============================================================================
+
+/// Backoff and bus-reset hook log
+struct RetryTrace {
+    uint32_t waits[8];
+    uint8_t waitCount;
+    uint32_t resets;
+};
+
+static void TraceWait(void* context, uint32_t ticks) {
+    RetryTrace* trace = static_cast<RetryTrace*>(context);
+    if (trace->waitCount < 8) {
+        trace->waits[trace->waitCount++] = ticks;
+    }
+}
+
+static void TraceReset(void* context) {
+    static_cast<RetryTrace*>(context)->resets++;
+}
+
+void TestRetryPolicy() {
+    TestHeader("TEST 32: Retry Policy Layer");
+    
+    RealI2CMock devices;
+    FlakyI2C flaky(devices);
+    RetryTrace trace = { {0}, 0, 0 };
+    RetryHooks hooks = { &TraceWait, &TraceReset, &trace };
+    RetryI2C retry(flaky, RetryPolicy{ 3, 1, 8, 0 }, hooks);
+    TMP100 sensor(retry, 0x48);
+    devices.SetSimulatedTemperature(23.0f);
+    Assert(sensor.Init(), "Sensor initialized through the retry layer");
+    
+    // Test: Transient NACKs cost retries, not the sample
+    Temperature t;
+    sensor.ReadTemperature(t);  // Pointer now on the temperature register: bare reads
+    flaky.FailNext(2, I2CStatus::Nack);
+    Assert(sensor.ReadTemperature(t) && t == Temperature::FromDegrees(23), "Read recovered after 2 NACKs");
+    const I2CDeviceStats* s = retry.GetStats(0x48);
+    Assert(s != nullptr && s->nacks == 2 && s->retries == 2 && s->recovered == 1 && s->failures == 0,
+           "Per-device NACK, retry and recovery counters");
+    Assert(trace.waitCount == 2 && trace.waits[0] == 1 && trace.waits[1] == 2 && s->backoffTicks == 3,
+           "Exponential backoff in ticks: 1, 2");
+    Assert(trace.resets == 0, "NACK is a device answer: no bus reset");
+    
+    // Test: Bounded: persistent failure returns the last status after maxRetries
+    trace.waitCount = 0;
+    retry.SetPolicy(RetryPolicy{ 5, 1, 4, 0 });
+    flaky.FailNext(6, I2CStatus::Timeout);
+    uint32_t before = flaky.GetAttempts();
+    Assert(!sensor.ReadTemperature(t) && flaky.GetAttempts() - before == 6, "1 attempt + 5 retries, then give up");
+    Assert(trace.waitCount == 5 && trace.waits[2] == 4 && trace.waits[4] == 4, "Backoff capped at maxBackoffTicks");
+    Assert(trace.resets == 5 && retry.GetBusResets() == 5 && s->timeouts == 6 && s->failures == 1,
+           "Timeouts reset the bus before each retry");
+    flaky.FailNext(1, I2CStatus::Error);
+    Assert(sensor.ReadTemperature(t) && s->errors == 1 && trace.resets == 6, "Bus error: reset, then recovered");
+    
+    // Test: ACK polls are not retried; the driver sees the write cycle NACKs
+    retry.SetPolicy(RetryPolicy{ 3, 1, 8, 0 });
+    EEPROM24FC256 eeprom(retry, 0x50);
+    devices.SetWriteCyclePolls(3);
+    uint8_t page[16];
+    std::memset(page, 0x3C, sizeof(page));
+    Assert(eeprom.WritePage(0x0600, page, sizeof(page)), "Page written through the retry layer");
+    const I2CDeviceStats* e = retry.GetStats(0x50);
+    Assert(e != nullptr && e->retries == 0 && e->nacks == 0 && devices.GetEepromNacks() == 3,
+           "3 ACK polls NACKed, none retried");
+    devices.SetWriteCyclePolls(0);
+    
+    // Test: An absent device stops costing retries
+    retry.SetPolicy(RetryPolicy{ 2, 1, 8, 3 });
+    TMP100 missing(retry, 0x49);
+    flaky.FailNext(1000, I2CStatus::Nack);
+    for (int i = 0; i < 3; i++) {
+        missing.ReadTemperature(t);
+    }
+    const I2CDeviceStats* m = retry.GetStats(0x49);
+    Assert(m != nullptr && m->retries == 6 && m->failStreak == 3, "3 failed transactions, 2 retries each");
+    before = flaky.GetAttempts();
+    missing.ReadTemperature(t);
+    Assert(flaky.GetAttempts() - before == 1 && m->retries == 6, "Dead device: single attempt, no backoff");
+    flaky.FailNext(0, I2CStatus::Nack);
+    Assert(missing.ReadTemperature(t) && m->failStreak == 0, "Device answers again: retries resume");
+    
+    // Test: Batch goes out once; only the failing entry is retried
+    MultiTMP100Mock multi;
+    FlakyI2C flakyMulti(multi);
+    RetryI2C retryMulti(flakyMulti, RetryPolicy{ 3, 0, 0, 0 });
+    TMP100Array<4> array(retryMulti);
+    array.Init(TMP100Base::ConversionMode::Continuous);
+    int16_t values[4];
+    array.Sweep(values);
+    before = flakyMulti.GetAttempts();
+    flakyMulti.FailNext(1, I2CStatus::Nack);  // First entry of the batch
+    Assert(array.Sweep(values) == 0x0F && values[0] == 320, "Sweep complete despite a NACKed entry");
+    Assert(flakyMulti.GetAttempts() - before == 5 && retryMulti.GetStats(0x48)->retries == 1 &&
+           retryMulti.GetStats(0x49)->retries == 0, "4 batched reads + 1 retry of sensor 0");
+    
+    // Test: Bus time eaten by retries, measured with the timing model
+    RealI2CMock timedDevices;
+    FlakyI2C timedFlaky(timedDevices);
+    TimedI2C timed(timedFlaky, TimedI2C::BusSpeed::FastPlus);
+    RetryI2C timedRetry(timed, RetryPolicy{ 3, 0, 0, 0 });
+    TMP100 timedSensor(timedRetry, 0x48);
+    timedSensor.Init();
+    timed.Advance(600000);
+    timedSensor.ReadTemperature(t);
+    timed.Reset();
+    timedSensor.ReadTemperature(t);
+    uint64_t clean = timed.GetBusMicros();
+    timed.Reset();
+    timedFlaky.FailNext(2, I2CStatus::Nack);
+    timedSensor.ReadTemperature(t);
+    I2CDeviceStats total = timedRetry.GetTotals();
+    Assert(timed.GetBusMicros() == 3 * clean && total.retryWireBytes == 2 * 3,
+           "Two retries triple the read's bus time (6 bytes re-sent)");
+    Assert(total.transactions >= 3 && total.recovered == 1 && total.addr == 0xFF, "Totals over all devices");
+}
+
+// ============================================================================
+// TEST 33: SysTick Timer
+// ============================================================================
+
+void TestSysTickTimer() {
+    TestHeader("TEST 33: SysTick Timer");
+    
+    static_assert(SysTickTimer::ReloadFor(SysTickTimer::DEFAULT_CORE_HZ) == 79999,
+                  "8 MHz / 100 Hz counts 80000 cycles per tick");
+    static_assert(SysTickTimer::ReloadFor(72000000) <= SysTickTimer::MAX_RELOAD, "72 MHz fits 24 bits");
+    
+    // Test: OnTick() counts ticks and rolls every TICK_HZ of them into a second
+    SysTickTimer timer;
+    timer.Init();
+    for (uint32_t i = 0; i < SysTickTimer::TICK_HZ - 1; i++) {
+        timer.OnTick();
+    }
+    Assert(timer.GetTicks() == 99 && timer.GetElapsedSeconds() == 0, "99 ticks: still second 0");
+    timer.OnTick();
+    Assert(timer.GetTicks() == 100 && timer.GetElapsedSeconds() == 1, "100th tick rolls into second 1");
+    for (uint32_t i = 0; i < 250; i++) {
+        timer.OnTick();
+    }
+    Assert(timer.GetTicks() == 350 && timer.GetElapsedSeconds() == 3, "Sub-second ticks carry over");
+    timer.Init();
+    Assert(timer.GetTicks() == 0 && timer.GetElapsedSeconds() == 0, "Init() restarts the counters");
+    
+    // Test: Deadlines compare across the 32-bit wrap
+    Assert(SysTickTimer::Reached(600, 600) && SysTickTimer::Reached(601, 600) &&
+           !SysTickTimer::Reached(599, 600), "Deadline reached at and after its second");
+    Assert(!SysTickTimer::Reached(0xFFFFFFF0u, 5) && SysTickTimer::Reached(5, 0xFFFFFFF0u),
+           "Deadline past the wrap is still ahead");
+    
+    // Test: Sleeping wakes on every tick (host: one tick per WFI) until the deadline
+    timer.SleepUntil(600);
+    Assert(timer.GetElapsedSeconds() == 600 && timer.GetTicks() == 600 * SysTickTimer::TICK_HZ,
+           "SleepUntil() returns on the deadline second");
+    timer.SleepUntil(10);
+    Assert(timer.GetTicks() == 600 * SysTickTimer::TICK_HZ, "Past deadline returns without sleeping");
+    timer.SleepTicks(7);
+    Assert(timer.GetTicks() == 600 * SysTickTimer::TICK_HZ + 7 && timer.GetElapsedSeconds() == 600,
+           "SleepTicks() waits whole ticks (retry backoff)");
+    
+    // Test: The main loop's schedule: alert checks every 60 s, a sample every
+    // 600 s started one conversion lead early, sleeping between events
+    timer.Init();
+    const uint32_t LOG_INTERVAL = 600;
+    const uint32_t CHECK_INTERVAL = 60;
+    const uint32_t LEAD = 1;
+    uint32_t lastLog = 0;
+    uint32_t lastCheck = 0;
+    bool started = false;
+    uint32_t logs[3] = { 0, 0, 0 };
+    uint32_t triggers[3] = { 0, 0, 0 };
+    uint8_t logCount = 0;
+    uint32_t checks = 0;
+    uint32_t wakeups = 0;
+    while (logCount < 3 && wakeups < 1000) {
+        uint32_t now = timer.GetElapsedSeconds();
+        if (now - lastCheck >= CHECK_INTERVAL) {
+            lastCheck = now;
+            checks++;
+        }
+        uint32_t elapsed = now - lastLog;
+        if (!started && elapsed >= LOG_INTERVAL - LEAD) {
+            triggers[logCount] = now;
+            started = true;
+        }
+        if (elapsed >= LOG_INTERVAL) {
+            logs[logCount++] = now;
+            lastLog = now;
+            started = false;
+        }
+        uint32_t nextEvent = lastLog + LOG_INTERVAL - (started ? 0 : LEAD);
+        if (lastCheck + CHECK_INTERVAL < nextEvent) {
+            nextEvent = lastCheck + CHECK_INTERVAL;
+        }
+        uint32_t current = timer.GetElapsedSeconds();
+        timer.SleepUntil(nextEvent > current ? nextEvent : current + 1);
+        wakeups++;
+    }
+    Assert(logs[0] == 600 && logs[1] == 1200 && logs[2] == 1800, "Samples exactly every 600 s");
+    Assert(triggers[0] == 599 && triggers[2] == 1799, "Conversion started one lead before each sample");
+    Assert(checks == 30 && wakeups == 34, "One pass per alert check and conversion start (plus the first)");
+    
+    // Test: Usable through the ITimer interface
+    ITimer& base = timer;
+    Assert(base.GetElapsedSeconds() == 1860, "ITimer view of the SysTick count (slept to the next check)");
+}
+
+// ============================================================================
+// TEST 34: Recoverable Sweep Log
+// ============================================================================
+
+void TestSweepLog() {
+    TestHeader("TEST 34: Recoverable Sweep Log");
+    
+    using Array = TMP100Array<4>;
+    RealI2CMock i2c;
+    EEPROM24FC256 eeprom(i2c, 0x50);
+    
+    // Test: 14-byte records, four per page, in a 4-page ring at page 8
+    SweepLog log(eeprom, Array::RECORD_BYTES, 8, 4);
+    Assert(log.GetRecordsPerPage() == 4, "Four 14-byte records per page");
+    Assert(log.Recover() && log.GetUsedPages() == 1 && log.GetLastTime() == 0, "Blank ring recovers empty");
+    
+    int16_t values[4];
+    const uint8_t mask = 0x0D;  // Channel 1 absent
+    bool ok = true;
+    for (uint32_t s = 0; s < 6; s++) {
+        for (uint8_t i = 0; i < 4; i++) {
+            values[i] = (i == 1) ? Array::INVALID : (int16_t)(s * 16 + i);
+        }
+        ok = Array::LogSweep(log, 1000 + s * 600, values, mask) && ok;
+    }
+    Assert(ok && log.Flush(), "Six sweeps logged");
+    
+    // Test: After a reset the head and the time limit come back from EEPROM
+    SweepLog after(eeprom, Array::RECORD_BYTES, 8, 4);
+    Assert(after.Recover(), "Recover after reset");
+    Assert(after.GetHeadPage() == 1 && after.GetHeadCount() == 2 && after.GetSequence() == 1,
+           "Head page and record count recovered");
+    Assert(after.GetLastTime() == 1000 + 5 * 600, "Newest timestamp recovered");
+    Assert(!Array::LogSweep(after, 1000 + 5 * 600 - 1, values, mask), "Older record rejected");
+    
+    // Test: Logging continues after the recovered records and wraps the ring
+    ok = true;
+    for (uint32_t s = 6; s < 20; s++) {
+        for (uint8_t i = 0; i < 4; i++) {
+            values[i] = (i == 1) ? Array::INVALID : (int16_t)(s * 16 + i);
+        }
+        ok = Array::LogSweep(after, 1000 + s * 600, values, mask) && ok;
+    }
+    Assert(ok && after.Flush(), "Fourteen more sweeps logged");
+    
+    SweepLog again(eeprom, Array::RECORD_BYTES, 8, 4);
+    Assert(again.Recover() && again.GetUsedPages() == 4 && again.GetHeadCount() == 0,
+           "Wrapped ring recovered; full head page opens the next one");
+    
+    uint8_t page[4 * Array::RECORD_BYTES];
+    uint8_t count = 0;
+    uint32_t t = 0;
+    int16_t back[4];
+    uint8_t backMask = 0;
+    Assert(again.ReadPage(0, page, count) && count == 4, "Oldest page holds four records");
+    Array::DecodeRecord(page, t, back, backMask);
+    Assert(t == 1000 + 8 * 600 && backMask == mask && back[0] == 128 && back[3] == 131 &&
+           back[1] == Array::INVALID, "Oldest surviving record decodes");
+    Assert(again.ReadPage(2, page, count) && count == 4, "Newest full page read back");
+    Array::DecodeRecord(&page[3 * Array::RECORD_BYTES], t, back, backMask);
+    Assert(t == 1000 + 19 * 600 && back[2] == 19 * 16 + 2, "Newest record decodes");
+    
+    // Test: Other pages and other record layouts are left alone
+    uint8_t outside = 0xAA;
+    eeprom.ReadBytes(7 * EEPROM24FC256::PAGE_SIZE + 63, &outside, 1);
+    Assert(outside == 0xFF, "Page before the ring untouched");
+    SweepLog other(eeprom, 12, 8, 4);
+    Assert(other.Recover() && other.GetUsedPages() == 1 && other.GetLastTime() == 0,
+           "Ring of another record size reads as empty");
+    Assert(!Array::LogSweep(other, 20000, values, mask), "Record of the wrong size rejected");
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -503,6 +3033,32 @@ int main() {
     TestFixedPointEncoding();
     TestErrorHandling();
     TestTimer();  // NEW: Timer and 10-minute interval tests
+    TestPageWriteBatching();
+    TestBulkSequentialRead();
+    TestAsyncWriteCycle();
+    TestCompressedLog();
+    TestPacked12();
+    TestLogRingRecovery();
+    TestTimeIndexedQuery();
+    TestStripedVolume();
+    TestEEPROMGeometry();
+    TestRollupLog();
+    TestReadCache();
+    TestOneShotConversion();
+    TestResolutionProfiles();
+    TestThresholdAlerts();
+    TestPointerCaching();
+    TestSensorArray();
+    TestFixedPointTemperature();
+    TestFilterPipeline();
+    TestScatterGather();
+    TestStaticBinding();
+    TestAsyncI2C();
+    TestBusTiming();
+    TestTrafficCapture();
+    TestRetryPolicy();
+    TestSysTickTimer();
+    TestSweepLog();
     
     // Print summary
     printf("\n");